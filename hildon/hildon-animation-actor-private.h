@@ -33,6 +33,16 @@ typedef struct                                  _HildonAnimationActorPrivate Hil
                                                 (G_TYPE_INSTANCE_GET_PRIVATE ((obj), \
                                                 HILDON_TYPE_ANIMATION_ACTOR, HildonAnimationActorPrivate));
 
+/* Properties whose value has been given at least once */
+typedef enum
+{
+    HILDON_AA_PROP_SHOW                         = 1 << 0,
+    HILDON_AA_PROP_POSITION                     = 1 << 1,
+    HILDON_AA_PROP_SCALE                        = 1 << 2,
+    HILDON_AA_PROP_ANCHOR                       = 1 << 3,
+    HILDON_AA_PROP_ROTATION                     = 1 << 4  /* one bit per axis */
+} HildonAnimationActorProp;
+
 struct                                          _HildonAnimationActorPrivate
 {
     guint      ready : 1;
@@ -44,6 +54,9 @@ struct                                          _HildonAnimationActorPrivate
     guint      set_anchor : 1;
     guint      set_parent : 1;
 
+    guint      known_props;
+    guint      transaction_depth;
+
     gboolean   show;
     guint      opacity;
 
@@ -143,6 +143,11 @@
  * }
  * </programlisting>
  * </example>
+ *
+ * Instead of calling the setters from a timeout, an animation can also
+ * be described with keyframes in a #HildonAnimationTimeline, which
+ * interpolates the properties of the actor on a clock shared by all
+ * the running timelines.
  */
 
 #include                                        <gdk/gdkx.h>
@@ -150,6 +155,7 @@
 
 #include                                        "hildon-animation-actor.h"
 #include                                        "hildon-animation-actor-private.h"
+#include                                        "hildon-private.h"
 
 G_DEFINE_TYPE (HildonAnimationActor, hildon_animation_actor, GTK_TYPE_WINDOW);
 
@@ -172,6 +178,12 @@ hildon_animation_actor_map_event (GtkWidget *widget,
 				  GdkEvent *event,
 				  gpointer user_data);
 
+static gboolean
+hildon_animation_actor_is_redundant (HildonAnimationActorPrivate *priv,
+                                     guint prop,
+                                     gboolean pending,
+                                     gboolean unchanged);
+
 static guint32 show_atom;
 static guint32 position_atom;
 static guint32 rotation_atom;
@@ -194,49 +206,26 @@ hildon_animation_actor_realize                 (GtkWidget *widget)
 
     display = gdk_drawable_get_display (widget->window);
 
-    wm_type = gdk_x11_get_xatom_by_name_for_display (display, "_NET_WM_WINDOW_TYPE");
-    applet_type = gdk_x11_get_xatom_by_name_for_display (display, "_HILDON_WM_WINDOW_TYPE_ANIMATION_ACTOR");
+    wm_type = hildon_private_get_xatom (display, HILDON_ATOM_NET_WM_WINDOW_TYPE);
+    applet_type = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_WM_WINDOW_TYPE_ANIMATION_ACTOR);
 
     XChangeProperty (GDK_DISPLAY_XDISPLAY (display), GDK_WINDOW_XID (widget->window), wm_type,
                      XA_ATOM, 32, PropModeReplace,
                      (unsigned char *) &applet_type, 1);
 
-    /* This is a bit of a hack, but for the sake of speed (it is assumed that
-     * once HildonAnimationActor is created, a lot of ClientMessages will
-     * follow), we cache all ClientMessages atoms in static variables. */
+    /* Sending a lot of ClientMessages is expected once a HildonAnimationActor is
+     * created, so the message atoms are kept in static variables. They all
+     * come from the hildon atom table, which interns them in one request. */
 
     if (!atoms_initialized)
     {
-	show_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_SHOW");
-	position_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION");
-	rotation_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION");
-	scale_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE");
-	anchor_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_ANCHOR");
-	parent_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_PARENT");
-	ready_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_ANIMATION_CLIENT_READY");
-#if 0
-	g_debug ("show atom = %lu\n", show_atom);
-	g_debug ("position atom = %lu\n", position_atom);
-	g_debug ("rotation atom = %lu\n", rotation_atom);
-	g_debug ("scale atom = %lu\n", scale_atom);
-	g_debug ("anchor atom = %lu\n", anchor_atom);
-	g_debug ("parent atom = %lu\n", parent_atom);
-	g_debug ("ready atom = %lu\n", ready_atom);
-#endif
+	show_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_SHOW);
+	position_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION);
+	rotation_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION);
+	scale_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE);
+	anchor_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_ANCHOR);
+	parent_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_PARENT);
+	ready_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_ANIMATION_CLIENT_READY);
 
 	atoms_initialized = TRUE;
     }
@@ -527,8 +516,92 @@ hildon_animation_actor_send_all_messages (HildonAnimationActor *self)
     hildon_animation_actor_send_pending_messages (self);
 }
 
+/*
+ * Tells whether setting a property would not change anything: its new
+ * value is the one already sent to the WM. Pending values are never
+ * redundant, so that send_pending_messages() can push them.
+ */
+static gboolean
+hildon_animation_actor_is_redundant (HildonAnimationActorPrivate *priv,
+                                     guint prop,
+                                     gboolean pending,
+                                     gboolean unchanged)
+{
+    if (unchanged && !pending && (priv->known_props & prop))
+	return TRUE;
+
+    priv->known_props |= prop;
+
+    return FALSE;
+}
+
 /* ------------------------------------------------------------- */
 
+/**
+ * hildon_animation_actor_begin_transaction:
+ * @self: A #HildonAnimationActor
+ *
+ * Starts collecting property changes of the animation actor instead of
+ * sending each of them to the window manager right away. The changes are
+ * sent together by hildon_animation_actor_commit_transaction(), so an
+ * animation frame that moves, scales and rotates the actor costs a single
+ * flush of the X connection.
+ *
+ * Transactions can be nested; changes are only sent when the outermost
+ * one is committed. Properties set again to their current value are
+ * never sent.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_actor_begin_transaction (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+
+    priv->transaction_depth++;
+}
+
+/**
+ * hildon_animation_actor_commit_transaction:
+ * @self: A #HildonAnimationActor
+ *
+ * Ends a transaction started with
+ * hildon_animation_actor_begin_transaction(). When the outermost
+ * transaction ends, the properties changed during it are sent to the
+ * window manager, followed by a single flush.
+ *
+ * If the animation actor WM-counterpart is not ready, the changes stay
+ * queued until the WM is ready for them.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_actor_commit_transaction (HildonAnimationActor *self)
+{
+    HildonAnimationActorPrivate *priv;
+    GtkWidget *widget;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_ACTOR (self));
+
+    priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
+    widget = GTK_WIDGET (self);
+
+    g_return_if_fail (priv->transaction_depth > 0);
+
+    if (--priv->transaction_depth > 0)
+	return;
+
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    {
+	hildon_animation_actor_send_pending_messages (self);
+	XFlush (GDK_WINDOW_XDISPLAY (widget->window));
+    }
+}
+
 /**
  * hildon_animation_actor_send_message:
  * @self: A #HildonAnimationActor
@@ -637,11 +710,17 @@ hildon_animation_actor_set_show_full (HildonAnimationActor *self,
     if (opacity < 0)
 	opacity = 0;
 
+    if (hildon_animation_actor_is_redundant (priv, HILDON_AA_PROP_SHOW,
+                                             priv->set_show,
+                                             priv->show == show &&
+                                             priv->opacity == opacity))
+	return;
+
     priv->show = show;
     priv->opacity = opacity;
     priv->set_show = 1;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	/* Defer show messages until the animation actor is parented
 	 * and the parent window is mapped */
@@ -746,12 +825,19 @@ hildon_animation_actor_set_position_full (HildonAnimationActor *self,
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
 
+    if (hildon_animation_actor_is_redundant (priv, HILDON_AA_PROP_POSITION,
+                                             priv->set_position,
+                                             priv->position_x == x &&
+                                             priv->position_y == y &&
+                                             priv->depth == depth))
+	return;
+
     priv->position_x = x;
     priv->position_y = y;
     priv->depth = depth;
     priv->set_position = 1;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	hildon_animation_actor_send_message (self,
 					     position_atom,
@@ -827,11 +913,17 @@ hildon_animation_actor_set_scalex (HildonAnimationActor *self,
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
 
+    if (hildon_animation_actor_is_redundant (priv, HILDON_AA_PROP_SCALE,
+                                             priv->set_scale,
+                                             priv->scale_x == x_scale &&
+                                             priv->scale_y == y_scale))
+	return;
+
     priv->scale_x = x_scale;
     priv->scale_y = y_scale;
     priv->set_scale = 1;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	hildon_animation_actor_send_message (self,
 					     scale_atom,
@@ -898,6 +990,31 @@ hildon_animation_actor_set_rotationx (HildonAnimationActor *self,
     GtkWidget          *widget = GTK_WIDGET (self);
 
     guint mask = 0;
+    gboolean unchanged;
+
+    switch (axis)
+    {
+	case HILDON_AA_X_AXIS:
+	    unchanged = priv->x_rotation_angle == degrees &&
+		        priv->x_rotation_y == y && priv->x_rotation_z == z;
+	    break;
+	case HILDON_AA_Y_AXIS:
+	    unchanged = priv->y_rotation_angle == degrees &&
+		        priv->y_rotation_x == x && priv->y_rotation_z == z;
+	    break;
+	case HILDON_AA_Z_AXIS:
+	    unchanged = priv->z_rotation_angle == degrees &&
+		        priv->z_rotation_x == x && priv->z_rotation_y == y;
+	    break;
+	default:
+	    return;
+    }
+
+    if (hildon_animation_actor_is_redundant (priv,
+                                             HILDON_AA_PROP_ROTATION << axis,
+                                             priv->set_rotation & (1 << axis),
+                                             unchanged))
+	return;
 
     switch (axis)
     {
@@ -925,7 +1042,7 @@ hildon_animation_actor_set_rotationx (HildonAnimationActor *self,
 
     priv->set_rotation |= mask;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	hildon_animation_actor_send_message (self,
 					     rotation_atom,
@@ -993,12 +1110,19 @@ hildon_animation_actor_set_anchor (HildonAnimationActor *self,
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
 
+    if (hildon_animation_actor_is_redundant (priv, HILDON_AA_PROP_ANCHOR,
+                                             priv->set_anchor,
+                                             priv->gravity == 0 &&
+                                             priv->anchor_x == x &&
+                                             priv->anchor_y == y))
+	return;
+
     priv->gravity = 0;
     priv->anchor_x = x;
     priv->anchor_y = y;
     priv->set_anchor = 1;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	hildon_animation_actor_send_message (self,
 					     anchor_atom,
@@ -1042,10 +1166,16 @@ hildon_animation_actor_set_anchor_from_gravity (HildonAnimationActor *self,
 	               *priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (self);
     GtkWidget          *widget = GTK_WIDGET (self);
 
+    if (hildon_animation_actor_is_redundant (priv, HILDON_AA_PROP_ANCHOR,
+                                             priv->set_anchor,
+                                             gravity != 0 &&
+                                             priv->gravity == gravity))
+	return;
+
     priv->gravity = gravity;
     priv->set_anchor = 1;
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	hildon_animation_actor_send_message (self,
 					     anchor_atom,
@@ -1172,7 +1302,7 @@ hildon_animation_actor_set_parent (HildonAnimationActor *self,
 	}
     }
 
-    if (GTK_WIDGET_MAPPED (widget) && priv->ready)
+    if (GTK_WIDGET_MAPPED (widget) && priv->ready && !priv->transaction_depth)
     {
 	Window win = 0;
 
@@ -102,6 +102,12 @@ hildon_animation_actor_send_message (HildonAnimationActor *self,
                                      guint32 l2,
                                      guint32 l3,
                                      guint32 l4);
+void
+hildon_animation_actor_begin_transaction (HildonAnimationActor *self);
+
+void
+hildon_animation_actor_commit_transaction (HildonAnimationActor *self);
+
 void
 hildon_animation_actor_set_show_full (HildonAnimationActor *self,
 				      gboolean show,
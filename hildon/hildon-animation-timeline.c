@@ -0,0 +1,700 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/**
+ * SECTION:hildon-animation-timeline
+ * @short_description: Keyframe animations for #HildonAnimationActor.
+ * @see_also: #HildonAnimationActor
+ *
+ * A #HildonAnimationTimeline animates the position, depth, scale,
+ * rotation and opacity of a #HildonAnimationActor along keyframes.
+ * Each keyframe gives the value of a property at a point in time
+ * and the easing curve used to reach it from the previous keyframe.
+ *
+ * All the timelines of a process are driven by a single clock, which
+ * only runs while at least one timeline is playing. On every tick, the
+ * properties of each actor are interpolated and applied in one
+ * animation actor transaction, so only the values that changed are
+ * sent to the window manager.
+ *
+ * <example>
+ * <title>Fading and sliding an actor in</title>
+ * <programlisting>
+ * HildonAnimationTimeline *timeline;
+ * <!-- -->
+ * timeline = hildon_animation_timeline_new (HILDON_ANIMATION_ACTOR (actor));
+ * <!-- -->
+ * hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+ *                                         0, -200, HILDON_ANIMATION_EASING_LINEAR);
+ * hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+ *                                         400, 0, HILDON_ANIMATION_EASING_EASE_OUT);
+ * hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_OPACITY,
+ *                                         0, 0, HILDON_ANIMATION_EASING_LINEAR);
+ * hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_OPACITY,
+ *                                         300, 255, HILDON_ANIMATION_EASING_LINEAR);
+ * <!-- -->
+ * g_signal_connect (timeline, "completed", G_CALLBACK (g_object_unref), NULL);
+ * hildon_animation_timeline_start (timeline);
+ * </programlisting>
+ * </example>
+ */
+
+#include                                        "hildon-animation-timeline.h"
+#include                                        "hildon-animation-timeline-private.h"
+#include                                        "hildon-animation-actor-private.h"
+
+G_DEFINE_TYPE (HildonAnimationTimeline, hildon_animation_timeline, G_TYPE_OBJECT);
+
+/* Interval of the clock shared by all the timelines, in milliseconds */
+#define                                         CLOCK_INTERVAL 16
+
+enum
+{
+    PROP_0,
+    PROP_ACTOR,
+    PROP_LOOP
+};
+
+enum
+{
+    COMPLETED,
+    LAST_SIGNAL
+};
+
+static guint                                    signals[LAST_SIGNAL] = { 0 };
+
+static GSList                                  *playing_timelines = NULL;
+
+static guint                                    clock_id = 0;
+
+static gboolean
+hildon_animation_timeline_clock_tick            (gpointer data);
+
+static void
+hildon_animation_timeline_set_property          (GObject *object,
+                                                 guint prop_id,
+                                                 const GValue *value,
+                                                 GParamSpec *pspec)
+{
+    HildonAnimationTimelinePrivate
+                       *priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (object);
+
+    switch (prop_id)
+    {
+        case PROP_ACTOR:
+            priv->actor = g_value_dup_object (value);
+            break;
+        case PROP_LOOP:
+            priv->loop = g_value_get_boolean (value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+            break;
+    }
+}
+
+static void
+hildon_animation_timeline_get_property          (GObject *object,
+                                                 guint prop_id,
+                                                 GValue *value,
+                                                 GParamSpec *pspec)
+{
+    HildonAnimationTimelinePrivate
+                       *priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (object);
+
+    switch (prop_id)
+    {
+        case PROP_ACTOR:
+            g_value_set_object (value, priv->actor);
+            break;
+        case PROP_LOOP:
+            g_value_set_boolean (value, priv->loop);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+            break;
+    }
+}
+
+static void
+hildon_animation_timeline_dispose               (GObject *object)
+{
+    HildonAnimationTimelinePrivate
+                       *priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (object);
+
+    if (priv->actor)
+    {
+        g_object_unref (priv->actor);
+        priv->actor = NULL;
+    }
+
+    G_OBJECT_CLASS (hildon_animation_timeline_parent_class)->dispose (object);
+}
+
+static void
+hildon_animation_timeline_finalize              (GObject *object)
+{
+    HildonAnimationTimeline *timeline = HILDON_ANIMATION_TIMELINE (object);
+
+    hildon_animation_timeline_clear_keyframes (timeline);
+
+    G_OBJECT_CLASS (hildon_animation_timeline_parent_class)->finalize (object);
+}
+
+static void
+hildon_animation_timeline_class_init            (HildonAnimationTimelineClass *klass)
+{
+    GObjectClass      *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->set_property     = hildon_animation_timeline_set_property;
+    gobject_class->get_property     = hildon_animation_timeline_get_property;
+    gobject_class->dispose          = hildon_animation_timeline_dispose;
+    gobject_class->finalize         = hildon_animation_timeline_finalize;
+
+    /**
+     * HildonAnimationTimeline:actor:
+     *
+     * The #HildonAnimationActor animated by the timeline.
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (gobject_class, PROP_ACTOR,
+                                     g_param_spec_object ("actor",
+                                                          "Actor",
+                                                          "The animation actor animated by the timeline",
+                                                          HILDON_TYPE_ANIMATION_ACTOR,
+                                                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+    /**
+     * HildonAnimationTimeline:loop:
+     *
+     * Whether the timeline starts over when it reaches its last keyframe.
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (gobject_class, PROP_LOOP,
+                                     g_param_spec_boolean ("loop",
+                                                           "Loop",
+                                                           "Whether the timeline starts over when it ends",
+                                                           FALSE,
+                                                           G_PARAM_READWRITE));
+
+    /**
+     * HildonAnimationTimeline::completed:
+     * @timeline: the timeline that received the signal
+     *
+     * Emitted when a timeline that does not loop has applied its last
+     * keyframes and stopped.
+     *
+     * Since: 2.2.25
+     */
+    signals[COMPLETED] = g_signal_new ("completed",
+                                       G_TYPE_FROM_CLASS (klass),
+                                       G_SIGNAL_RUN_LAST,
+                                       G_STRUCT_OFFSET (HildonAnimationTimelineClass, completed),
+                                       NULL, NULL,
+                                       g_cclosure_marshal_VOID__VOID,
+                                       G_TYPE_NONE, 0);
+
+    g_type_class_add_private (klass, sizeof (HildonAnimationTimelinePrivate));
+}
+
+static void
+hildon_animation_timeline_init                  (HildonAnimationTimeline *self)
+{
+}
+
+/**
+ * hildon_animation_timeline_new:
+ * @actor: the #HildonAnimationActor to animate
+ *
+ * Creates a new #HildonAnimationTimeline without keyframes.
+ *
+ * Return value: A #HildonAnimationTimeline
+ *
+ * Since: 2.2.25
+ **/
+HildonAnimationTimeline*
+hildon_animation_timeline_new                   (HildonAnimationActor *actor)
+{
+    g_return_val_if_fail (HILDON_IS_ANIMATION_ACTOR (actor), NULL);
+
+    return g_object_new (HILDON_TYPE_ANIMATION_TIMELINE, "actor", actor, NULL);
+}
+
+/**
+ * hildon_animation_timeline_get_actor:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Gets the animation actor animated by @timeline.
+ *
+ * Return value: the #HildonAnimationActor
+ *
+ * Since: 2.2.25
+ **/
+HildonAnimationActor*
+hildon_animation_timeline_get_actor             (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline), NULL);
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    return priv->actor;
+}
+
+/**
+ * hildon_animation_timeline_add_keyframe:
+ * @timeline: A #HildonAnimationTimeline
+ * @property: the animated property
+ * @msecs: time of the keyframe, in milliseconds from the start
+ * @value: value of @property at @msecs
+ * @easing: curve used to interpolate from the previous keyframe of
+ * @property
+ *
+ * Adds a keyframe to @timeline, replacing the keyframe of @property at
+ * @msecs if there is one. Before its first keyframe and after its last
+ * one, a property keeps the value of that keyframe. Properties without
+ * keyframes are not touched by the timeline.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_timeline_add_keyframe          (HildonAnimationTimeline *timeline,
+                                                 HildonAnimationProperty property,
+                                                 guint msecs,
+                                                 gdouble value,
+                                                 HildonAnimationEasing easing)
+{
+    HildonAnimationTimelinePrivate *priv;
+    HildonAnimationKeyframe keyframe;
+    GArray *keyframes;
+    guint i;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline));
+    g_return_if_fail (property < HILDON_ANIMATION_N_PROPERTIES);
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    if (priv->keyframes[property] == NULL)
+        priv->keyframes[property] = g_array_new (FALSE, FALSE, sizeof (HildonAnimationKeyframe));
+
+    keyframes = priv->keyframes[property];
+
+    keyframe.msecs = msecs;
+    keyframe.value = value;
+    keyframe.easing = easing;
+
+    for (i = 0; i < keyframes->len; i++)
+    {
+        HildonAnimationKeyframe *k = &g_array_index (keyframes, HildonAnimationKeyframe, i);
+
+        if (k->msecs == msecs)
+        {
+            *k = keyframe;
+            return;
+        }
+
+        if (k->msecs > msecs)
+            break;
+    }
+
+    g_array_insert_val (keyframes, i, keyframe);
+
+    priv->duration = MAX (priv->duration, msecs);
+}
+
+/**
+ * hildon_animation_timeline_clear_keyframes:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Removes all the keyframes of @timeline.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_timeline_clear_keyframes       (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+    guint i;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline));
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    for (i = 0; i < HILDON_ANIMATION_N_PROPERTIES; i++)
+    {
+        if (priv->keyframes[i])
+        {
+            g_array_free (priv->keyframes[i], TRUE);
+            priv->keyframes[i] = NULL;
+        }
+    }
+
+    priv->duration = 0;
+}
+
+/**
+ * hildon_animation_timeline_get_duration:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Gets the time of the last keyframe of @timeline.
+ *
+ * Return value: the duration of @timeline, in milliseconds
+ *
+ * Since: 2.2.25
+ **/
+guint
+hildon_animation_timeline_get_duration          (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline), 0);
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    return priv->duration;
+}
+
+/**
+ * hildon_animation_timeline_set_loop:
+ * @timeline: A #HildonAnimationTimeline
+ * @loop: whether @timeline should loop
+ *
+ * Sets whether @timeline starts over when it reaches its last keyframe,
+ * instead of stopping and emitting #HildonAnimationTimeline::completed.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_timeline_set_loop              (HildonAnimationTimeline *timeline,
+                                                 gboolean loop)
+{
+    g_return_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline));
+
+    g_object_set (timeline, "loop", loop, NULL);
+}
+
+/**
+ * hildon_animation_timeline_get_loop:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Gets whether @timeline loops.
+ *
+ * Return value: %TRUE if @timeline loops
+ *
+ * Since: 2.2.25
+ **/
+gboolean
+hildon_animation_timeline_get_loop              (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline), FALSE);
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    return priv->loop;
+}
+
+static gdouble
+hildon_animation_timeline_ease                  (HildonAnimationEasing easing,
+                                                 gdouble progress)
+{
+    switch (easing)
+    {
+        case HILDON_ANIMATION_EASING_EASE_IN:
+            return progress * progress;
+        case HILDON_ANIMATION_EASING_EASE_OUT:
+            return progress * (2 - progress);
+        case HILDON_ANIMATION_EASING_EASE_IN_OUT:
+            if (progress < 0.5)
+                return 2 * progress * progress;
+            return -1 + (4 - 2 * progress) * progress;
+        case HILDON_ANIMATION_EASING_LINEAR:
+        default:
+            return progress;
+    }
+}
+
+static gdouble
+hildon_animation_timeline_interpolate           (GArray *keyframes,
+                                                 guint msecs)
+{
+    HildonAnimationKeyframe *from, *to;
+    gdouble progress;
+    guint i;
+
+    to = &g_array_index (keyframes, HildonAnimationKeyframe, 0);
+    if (msecs <= to->msecs)
+        return to->value;
+
+    for (i = 1; i < keyframes->len; i++)
+    {
+        from = to;
+        to = &g_array_index (keyframes, HildonAnimationKeyframe, i);
+
+        if (msecs < to->msecs)
+        {
+            progress = (gdouble) (msecs - from->msecs) / (to->msecs - from->msecs);
+            progress = hildon_animation_timeline_ease (to->easing, progress);
+
+            return from->value + (to->value - from->value) * progress;
+        }
+    }
+
+    return to->value;
+}
+
+/*
+ * Sets the properties of the actor to their values at @msecs. The
+ * actor setters skip the values that did not change since the last
+ * frame, and the transaction sends the rest with a single flush.
+ */
+static void
+hildon_animation_timeline_apply                 (HildonAnimationTimeline *timeline,
+                                                 guint msecs)
+{
+    HildonAnimationTimelinePrivate
+                       *priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+    HildonAnimationActorPrivate *actor_priv;
+    HildonAnimationActor *actor = priv->actor;
+    gdouble values[HILDON_ANIMATION_N_PROPERTIES];
+    guint i;
+
+    if (actor == NULL)
+        return;
+
+    actor_priv = HILDON_ANIMATION_ACTOR_GET_PRIVATE (actor);
+
+    for (i = 0; i < HILDON_ANIMATION_N_PROPERTIES; i++)
+    {
+        if (priv->keyframes[i])
+            values[i] = hildon_animation_timeline_interpolate (priv->keyframes[i], msecs);
+    }
+
+    hildon_animation_actor_begin_transaction (actor);
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_X] ||
+        priv->keyframes[HILDON_ANIMATION_PROPERTY_Y] ||
+        priv->keyframes[HILDON_ANIMATION_PROPERTY_DEPTH])
+    {
+        gint x = priv->keyframes[HILDON_ANIMATION_PROPERTY_X] ?
+            (gint) values[HILDON_ANIMATION_PROPERTY_X] : (gint) actor_priv->position_x;
+        gint y = priv->keyframes[HILDON_ANIMATION_PROPERTY_Y] ?
+            (gint) values[HILDON_ANIMATION_PROPERTY_Y] : (gint) actor_priv->position_y;
+        gint depth = priv->keyframes[HILDON_ANIMATION_PROPERTY_DEPTH] ?
+            (gint) values[HILDON_ANIMATION_PROPERTY_DEPTH] : (gint) actor_priv->depth;
+
+        hildon_animation_actor_set_position_full (actor, x, y, depth);
+    }
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_SCALE_X] ||
+        priv->keyframes[HILDON_ANIMATION_PROPERTY_SCALE_Y])
+    {
+        gint32 scale_x = priv->keyframes[HILDON_ANIMATION_PROPERTY_SCALE_X] ?
+            (gint32) (values[HILDON_ANIMATION_PROPERTY_SCALE_X] * (1 << 16)) : actor_priv->scale_x;
+        gint32 scale_y = priv->keyframes[HILDON_ANIMATION_PROPERTY_SCALE_Y] ?
+            (gint32) (values[HILDON_ANIMATION_PROPERTY_SCALE_Y] * (1 << 16)) : actor_priv->scale_y;
+
+        hildon_animation_actor_set_scalex (actor, scale_x, scale_y);
+    }
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_ROTATION_X])
+        hildon_animation_actor_set_rotation (actor, HILDON_AA_X_AXIS,
+                                             values[HILDON_ANIMATION_PROPERTY_ROTATION_X],
+                                             0,
+                                             actor_priv->x_rotation_y,
+                                             actor_priv->x_rotation_z);
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_ROTATION_Y])
+        hildon_animation_actor_set_rotation (actor, HILDON_AA_Y_AXIS,
+                                             values[HILDON_ANIMATION_PROPERTY_ROTATION_Y],
+                                             actor_priv->y_rotation_x,
+                                             0,
+                                             actor_priv->y_rotation_z);
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_ROTATION_Z])
+        hildon_animation_actor_set_rotation (actor, HILDON_AA_Z_AXIS,
+                                             values[HILDON_ANIMATION_PROPERTY_ROTATION_Z],
+                                             actor_priv->z_rotation_x,
+                                             actor_priv->z_rotation_y,
+                                             0);
+
+    if (priv->keyframes[HILDON_ANIMATION_PROPERTY_OPACITY])
+        hildon_animation_actor_set_opacity (actor,
+                                            (gint) values[HILDON_ANIMATION_PROPERTY_OPACITY]);
+
+    hildon_animation_actor_commit_transaction (actor);
+}
+
+static void
+hildon_animation_timeline_advance               (HildonAnimationTimeline *timeline,
+                                                 GTimeVal *now)
+{
+    HildonAnimationTimelinePrivate
+                       *priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+    glong elapsed;
+
+    /* It may have been stopped by an earlier timeline of this tick */
+    if (!priv->playing)
+        return;
+
+    elapsed = (now->tv_sec - priv->start_time.tv_sec) * 1000 +
+        (now->tv_usec - priv->start_time.tv_usec) / 1000;
+
+    if (elapsed < 0)
+        elapsed = 0;
+
+    if (elapsed < priv->duration)
+    {
+        hildon_animation_timeline_apply (timeline, elapsed);
+    }
+    else if (priv->loop && priv->duration > 0)
+    {
+        glong cycles = elapsed / priv->duration;
+
+        g_time_val_add (&priv->start_time, cycles * priv->duration * 1000);
+        hildon_animation_timeline_apply (timeline, elapsed % priv->duration);
+    }
+    else
+    {
+        hildon_animation_timeline_apply (timeline, priv->duration);
+        hildon_animation_timeline_stop (timeline);
+        g_signal_emit (timeline, signals[COMPLETED], 0);
+    }
+}
+
+static gboolean
+hildon_animation_timeline_clock_tick            (gpointer data)
+{
+    GSList *timelines, *iter;
+    GTimeVal now;
+
+    g_get_current_time (&now);
+
+    /* Timelines may be stopped, started or finalized by the handlers of
+     * "completed", so walk over a referenced copy of the list */
+    timelines = g_slist_copy (playing_timelines);
+    g_slist_foreach (timelines, (GFunc) g_object_ref, NULL);
+
+    for (iter = timelines; iter != NULL; iter = iter->next)
+        hildon_animation_timeline_advance (iter->data, &now);
+
+    g_slist_foreach (timelines, (GFunc) g_object_unref, NULL);
+    g_slist_free (timelines);
+
+    if (playing_timelines == NULL)
+    {
+        clock_id = 0;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * hildon_animation_timeline_start:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Starts playing @timeline from its beginning. The properties at time
+ * zero are applied right away. A playing timeline holds a reference on
+ * itself, which is released when it stops.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_timeline_start                 (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline));
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    g_get_current_time (&priv->start_time);
+
+    if (!priv->playing)
+    {
+        priv->playing = TRUE;
+        playing_timelines = g_slist_prepend (playing_timelines, g_object_ref (timeline));
+    }
+
+    hildon_animation_timeline_apply (timeline, 0);
+
+    if (clock_id == 0)
+        clock_id = gdk_threads_add_timeout_full (GDK_PRIORITY_REDRAW, CLOCK_INTERVAL,
+                                                 hildon_animation_timeline_clock_tick,
+                                                 NULL, NULL);
+}
+
+/**
+ * hildon_animation_timeline_stop:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Stops playing @timeline, leaving the actor as it is.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_animation_timeline_stop                  (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline));
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    if (!priv->playing)
+        return;
+
+    priv->playing = FALSE;
+    playing_timelines = g_slist_remove (playing_timelines, timeline);
+
+    /* The clock stops by itself on its next tick */
+    g_object_unref (timeline);
+}
+
+/**
+ * hildon_animation_timeline_is_playing:
+ * @timeline: A #HildonAnimationTimeline
+ *
+ * Gets whether @timeline is playing.
+ *
+ * Return value: %TRUE if @timeline is playing
+ *
+ * Since: 2.2.25
+ **/
+gboolean
+hildon_animation_timeline_is_playing            (HildonAnimationTimeline *timeline)
+{
+    HildonAnimationTimelinePrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_ANIMATION_TIMELINE (timeline), FALSE);
+
+    priv = HILDON_ANIMATION_TIMELINE_GET_PRIVATE (timeline);
+
+    return priv->playing;
+}
@@ -0,0 +1,163 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef                                         __HILDON_ANIMATION_TIMELINE_H__
+#define                                         __HILDON_ANIMATION_TIMELINE_H__
+
+#include                                        "hildon-animation-actor.h"
+
+G_BEGIN_DECLS
+
+#define                                         HILDON_TYPE_ANIMATION_TIMELINE \
+                                                (hildon_animation_timeline_get_type())
+
+#define                                         HILDON_ANIMATION_TIMELINE(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_CAST ((obj), \
+                                                HILDON_TYPE_ANIMATION_TIMELINE, \
+                                                HildonAnimationTimeline))
+
+#define                                         HILDON_ANIMATION_TIMELINE_CLASS(klass) \
+                                                (G_TYPE_CHECK_CLASS_CAST ((klass), \
+                                                HILDON_TYPE_ANIMATION_TIMELINE, \
+                                                HildonAnimationTimelineClass))
+
+#define                                         HILDON_IS_ANIMATION_TIMELINE(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_TYPE ((obj), \
+                                                HILDON_TYPE_ANIMATION_TIMELINE))
+
+#define                                         HILDON_IS_ANIMATION_TIMELINE_CLASS(klass) \
+                                                (G_TYPE_CHECK_CLASS_TYPE ((klass), \
+                                                HILDON_TYPE_ANIMATION_TIMELINE))
+
+#define                                         HILDON_ANIMATION_TIMELINE_GET_CLASS(obj) \
+                                                (G_TYPE_INSTANCE_GET_CLASS ((obj), \
+                                                HILDON_TYPE_ANIMATION_TIMELINE, \
+                                                HildonAnimationTimelineClass))
+
+typedef struct                                  _HildonAnimationTimeline HildonAnimationTimeline;
+typedef struct                                  _HildonAnimationTimelineClass HildonAnimationTimelineClass;
+
+struct                                          _HildonAnimationTimelineClass
+{
+    GObjectClass parent_class;
+
+    void (*completed) (HildonAnimationTimeline *timeline);
+
+    /* Padding for future extension */
+    void (*_hildon_reserved1)(void);
+    void (*_hildon_reserved2)(void);
+    void (*_hildon_reserved3)(void);
+};
+
+struct                                          _HildonAnimationTimeline
+{
+    GObject parent;
+};
+
+/**
+ * HildonAnimationProperty:
+ * @HILDON_ANIMATION_PROPERTY_X: X coordinate of the actor position.
+ * @HILDON_ANIMATION_PROPERTY_Y: Y coordinate of the actor position.
+ * @HILDON_ANIMATION_PROPERTY_DEPTH: Depth (Z coordinate) of the actor.
+ * @HILDON_ANIMATION_PROPERTY_SCALE_X: Scale factor along the X-axis.
+ * @HILDON_ANIMATION_PROPERTY_SCALE_Y: Scale factor along the Y-axis.
+ * @HILDON_ANIMATION_PROPERTY_ROTATION_X: Rotation around the X-axis, in degrees.
+ * @HILDON_ANIMATION_PROPERTY_ROTATION_Y: Rotation around the Y-axis, in degrees.
+ * @HILDON_ANIMATION_PROPERTY_ROTATION_Z: Rotation around the Z-axis, in degrees.
+ * @HILDON_ANIMATION_PROPERTY_OPACITY: Opacity, from 0 to 255.
+ *
+ * Animation actor properties that can be driven by a
+ * #HildonAnimationTimeline.
+ **/
+typedef enum
+{
+    HILDON_ANIMATION_PROPERTY_X,
+    HILDON_ANIMATION_PROPERTY_Y,
+    HILDON_ANIMATION_PROPERTY_DEPTH,
+    HILDON_ANIMATION_PROPERTY_SCALE_X,
+    HILDON_ANIMATION_PROPERTY_SCALE_Y,
+    HILDON_ANIMATION_PROPERTY_ROTATION_X,
+    HILDON_ANIMATION_PROPERTY_ROTATION_Y,
+    HILDON_ANIMATION_PROPERTY_ROTATION_Z,
+    HILDON_ANIMATION_PROPERTY_OPACITY
+}                                               HildonAnimationProperty;
+
+/**
+ * HildonAnimationEasing:
+ * @HILDON_ANIMATION_EASING_LINEAR: Constant speed.
+ * @HILDON_ANIMATION_EASING_EASE_IN: Accelerates from zero speed.
+ * @HILDON_ANIMATION_EASING_EASE_OUT: Decelerates to zero speed.
+ * @HILDON_ANIMATION_EASING_EASE_IN_OUT: Accelerates, then decelerates.
+ *
+ * Curves used to interpolate a property between two keyframes.
+ **/
+typedef enum
+{
+    HILDON_ANIMATION_EASING_LINEAR,
+    HILDON_ANIMATION_EASING_EASE_IN,
+    HILDON_ANIMATION_EASING_EASE_OUT,
+    HILDON_ANIMATION_EASING_EASE_IN_OUT
+}                                               HildonAnimationEasing;
+
+GType
+hildon_animation_timeline_get_type              (void) G_GNUC_CONST;
+
+HildonAnimationTimeline*
+hildon_animation_timeline_new                   (HildonAnimationActor *actor);
+
+HildonAnimationActor*
+hildon_animation_timeline_get_actor             (HildonAnimationTimeline *timeline);
+
+void
+hildon_animation_timeline_add_keyframe          (HildonAnimationTimeline *timeline,
+                                                 HildonAnimationProperty property,
+                                                 guint msecs,
+                                                 gdouble value,
+                                                 HildonAnimationEasing easing);
+
+void
+hildon_animation_timeline_clear_keyframes       (HildonAnimationTimeline *timeline);
+
+guint
+hildon_animation_timeline_get_duration          (HildonAnimationTimeline *timeline);
+
+void
+hildon_animation_timeline_set_loop              (HildonAnimationTimeline *timeline,
+                                                 gboolean loop);
+
+gboolean
+hildon_animation_timeline_get_loop              (HildonAnimationTimeline *timeline);
+
+void
+hildon_animation_timeline_start                 (HildonAnimationTimeline *timeline);
+
+void
+hildon_animation_timeline_stop                  (HildonAnimationTimeline *timeline);
+
+gboolean
+hildon_animation_timeline_is_playing            (HildonAnimationTimeline *timeline);
+
+G_END_DECLS
+
+#endif                                          /* __HILDON_ANIMATION_TIMELINE_H__ */
@@ -41,6 +41,17 @@ struct                                          _HildonAppMenuPrivate
     gint width_request;
     guint find_intruder_idle_id;
     guint hide_idle_id;
+    guint relayout_idle_id;
+    gboolean items_dirty;
+    gboolean filters_dirty;
+    guint prepare_idle_id;
+
+    /* Popup latency statistics */
+    GTimeVal popup_time;
+    gboolean popup_pending;
+    guint n_popups;
+    guint last_popup_latency;
+    guint max_popup_latency;
 };
 
 void G_GNUC_INTERNAL
@@ -53,6 +64,9 @@ hildon_app_menu_get_parent_window              (HildonAppMenu *self);
 gboolean G_GNUC_INTERNAL
 hildon_app_menu_has_visible_children (HildonAppMenu *menu);
 
+void G_GNUC_INTERNAL
+hildon_app_menu_prepare                        (HildonAppMenu *menu);
+
 G_END_DECLS
 
 #endif /* __HILDON_APP_MENU_PRIVATE_H__ */
@@ -102,16 +102,18 @@
 #include                                        "hildon-gtk.h"
 #include                                        "hildon-app-menu.h"
 #include                                        "hildon-app-menu-private.h"
+#include                                        "hildon-private.h"
 #include                                        "hildon-window.h"
 #include                                        "hildon-banner.h"
 #include                                        "hildon-animation-actor.h"
 
 static void
-hildon_app_menu_repack_items                    (HildonAppMenu *menu,
-                                                 gint           start_from);
+hildon_app_menu_queue_relayout                  (HildonAppMenu *menu,
+                                                 gboolean       items,
+                                                 gboolean       filters);
 
 static void
-hildon_app_menu_repack_filters                  (HildonAppMenu *menu);
+hildon_app_menu_flush_relayout                  (HildonAppMenu *menu);
 
 static gboolean
 can_activate_accel                              (GtkWidget *widget,
@@ -197,7 +199,7 @@ hildon_app_menu_insert                          (HildonAppMenu *menu,
     g_object_ref_sink (item);
     priv->buttons = g_list_insert (priv->buttons, item, position);
     if (GTK_WIDGET_VISIBLE (item))
-        hildon_app_menu_repack_items (menu, position);
+        hildon_app_menu_queue_relayout (menu, TRUE, FALSE);
 
     /* Enable accelerators */
     g_signal_connect (item, "can-activate-accel", G_CALLBACK (can_activate_accel), NULL);
@@ -276,7 +278,7 @@ hildon_app_menu_reorder_child                   (HildonAppMenu *menu,
     priv->buttons = g_list_remove (priv->buttons, item);
     priv->buttons = g_list_insert (priv->buttons, item, position);
 
-    hildon_app_menu_repack_items (menu, MIN (old_position, position));
+    hildon_app_menu_queue_relayout (menu, TRUE, FALSE);
 }
 
 /**
@@ -309,7 +311,7 @@ hildon_app_menu_add_filter                      (HildonAppMenu *menu,
     g_object_ref_sink (filter);
     priv->filters = g_list_append (priv->filters, filter);
     if (GTK_WIDGET_VISIBLE (filter))
-        hildon_app_menu_repack_filters (menu);
+        hildon_app_menu_queue_relayout (menu, FALSE, TRUE);
 
     /* Enable accelerators */
     g_signal_connect (filter, "can-activate-accel", G_CALLBACK (can_activate_accel), NULL);
@@ -338,7 +340,7 @@ hildon_app_menu_set_columns                     (HildonAppMenu *menu,
 
     if (columns != priv->columns) {
         priv->columns = columns;
-        hildon_app_menu_repack_items (menu, 0);
+        hildon_app_menu_queue_relayout (menu, TRUE, FALSE);
     }
 }
 
@@ -428,7 +430,7 @@ item_visibility_changed                         (GtkWidget     *item,
     HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
 
     if (! priv->inhibit_repack)
-        hildon_app_menu_repack_items (menu, g_list_index (priv->buttons, item));
+        hildon_app_menu_queue_relayout (menu, TRUE, FALSE);
     g_signal_emit (menu, app_menu_signals[CHANGED], 0);
 }
 
@@ -440,7 +442,7 @@ filter_visibility_changed                       (GtkWidget     *item,
     HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
 
     if (! priv->inhibit_repack)
-        hildon_app_menu_repack_filters (menu);
+        hildon_app_menu_queue_relayout (menu, FALSE, TRUE);
     g_signal_emit (menu, app_menu_signals[CHANGED], 0);
 }
 
@@ -472,8 +474,7 @@ hildon_app_menu_show_all                        (GtkWidget *widget)
 
     priv->inhibit_repack = FALSE;
 
-    hildon_app_menu_repack_items (menu, 0);
-    hildon_app_menu_repack_filters (menu);
+    hildon_app_menu_queue_relayout (menu, TRUE, TRUE);
 }
 
 
@@ -491,8 +492,7 @@ hildon_app_menu_hide_all                        (GtkWidget *widget)
 
     priv->inhibit_repack = FALSE;
 
-    hildon_app_menu_repack_items (menu, 0);
-    hildon_app_menu_repack_filters (menu);
+    hildon_app_menu_queue_relayout (menu, TRUE, TRUE);
 }
 
 /*
@@ -543,6 +543,38 @@ hildon_app_menu_find_intruder                   (gpointer data)
     return FALSE;
 }
 
+static void
+hildon_app_menu_show                            (GtkWidget *widget)
+{
+    /* Make sure the menu is requested with its final layout */
+    hildon_app_menu_flush_relayout (HILDON_APP_MENU (widget));
+
+    GTK_WIDGET_CLASS (hildon_app_menu_parent_class)->show (widget);
+}
+
+static gboolean
+hildon_app_menu_expose                          (GtkWidget      *widget,
+                                                 GdkEventExpose *event)
+{
+    HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (widget);
+
+    if (priv->popup_pending) {
+        GTimeVal now;
+        glong latency;
+
+        g_get_current_time (&now);
+        latency = (now.tv_sec - priv->popup_time.tv_sec) * G_USEC_PER_SEC +
+            (now.tv_usec - priv->popup_time.tv_usec);
+
+        priv->popup_pending = FALSE;
+        priv->n_popups++;
+        priv->last_popup_latency = MAX (latency, 0);
+        priv->max_popup_latency = MAX (priv->max_popup_latency, priv->last_popup_latency);
+    }
+
+    return GTK_WIDGET_CLASS (hildon_app_menu_parent_class)->expose_event (widget, event);
+}
+
 static void
 hildon_app_menu_map                             (GtkWidget *widget)
 {
@@ -669,8 +701,8 @@ hildon_app_menu_realize                         (GtkWidget *widget)
     gdkdisplay = gdk_drawable_get_display (widget->window);
     xdisplay = GDK_WINDOW_XDISPLAY (widget->window);
 
-    property = gdk_x11_get_xatom_by_name_for_display (gdkdisplay, "_NET_WM_WINDOW_TYPE");
-    window_type = XInternAtom (xdisplay, "_HILDON_WM_WINDOW_TYPE_APP_MENU", False);
+    property = hildon_private_get_xatom (gdkdisplay, HILDON_ATOM_NET_WM_WINDOW_TYPE);
+    window_type = hildon_private_get_xatom (gdkdisplay, HILDON_ATOM_HILDON_WM_WINDOW_TYPE_APP_MENU);
     XChangeProperty (xdisplay, GDK_WINDOW_XID (widget->window), property,
                      XA_ATOM, 32, PropModeReplace, (guchar *) &window_type, 1);
 
@@ -747,92 +779,198 @@ hildon_app_menu_style_set                       (GtkWidget *widget,
     hildon_app_menu_apply_style (widget);
 }
 
+/*
+ * Packs the visible filters in order. Only the filters that appeared,
+ * disappeared or moved are touched.
+ */
 static void
 hildon_app_menu_repack_filters                  (HildonAppMenu *menu)
 {
     HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE(menu);
+    GtkContainer *hbox = GTK_CONTAINER (priv->filters_hbox);
     GList *iter;
+    gint position = 0;
 
     for (iter = priv->filters; iter != NULL; iter = iter->next) {
         GtkWidget *filter = GTK_WIDGET (iter->data);
         GtkWidget *parent = gtk_widget_get_parent (filter);
-        if (parent) {
-            g_object_ref (filter);
-            gtk_container_remove (GTK_CONTAINER (parent), filter);
+
+        if (!GTK_WIDGET_VISIBLE (filter)) {
+            /* The menu owns detached filters */
+            if (parent) {
+                g_object_ref (filter);
+                gtk_container_remove (GTK_CONTAINER (parent), filter);
+            }
+            continue;
         }
-    }
 
-    for (iter = priv->filters; iter != NULL; iter = iter->next) {
-        GtkWidget *filter = GTK_WIDGET (iter->data);
-        if (GTK_WIDGET_VISIBLE (filter)) {
-            gtk_box_pack_start (GTK_BOX (priv->filters_hbox), filter, TRUE, TRUE, 0);
+        if (parent != GTK_WIDGET (hbox)) {
+            if (parent) {
+                g_object_ref (filter);
+                gtk_container_remove (GTK_CONTAINER (parent), filter);
+            }
+            gtk_box_pack_start (priv->filters_hbox, filter, TRUE, TRUE, 0);
+            /* The box takes over the reference of the menu */
             g_object_unref (filter);
+            gtk_box_reorder_child (priv->filters_hbox, filter, position);
             /* GtkButton must be realized for accelerators to work */
             gtk_widget_realize (filter);
+        } else {
+            gint current;
+
+            gtk_container_child_get (hbox, filter, "position", &current, NULL);
+            if (current != position)
+                gtk_box_reorder_child (priv->filters_hbox, filter, position);
         }
+
+        position++;
     }
 }
 
 /*
  * When items displayed in the menu change (e.g, a new item is added,
  * an item is hidden or the list is reordered), the layout must be
- * updated. To do this we repack all items starting from a given one.
+ * updated. Items that keep their cell are left alone, the ones whose
+ * cell changed are moved within the table, and only the items that
+ * become visible are attached (and realized).
  */
 static void
-hildon_app_menu_repack_items                    (HildonAppMenu *menu,
-                                                 gint           start_from)
+hildon_app_menu_repack_items                    (HildonAppMenu *menu)
 {
     HildonAppMenuPrivate *priv;
-    gint row, col, nvisible, i;
+    GtkContainer *table;
+    guint row, col, nvisible, nrows;
+    gboolean changed = FALSE;
     GList *iter;
 
     priv = HILDON_APP_MENU_GET_PRIVATE(menu);
+    table = GTK_CONTAINER (priv->table);
 
-    i = nvisible = 0;
+    /* Detach hidden items, so they don't keep rows in the table */
+    nvisible = 0;
     for (iter = priv->buttons; iter != NULL; iter = iter->next) {
-        /* Count number of visible items */
-        if (GTK_WIDGET_VISIBLE (iter->data))
+        GtkWidget *item = GTK_WIDGET (iter->data);
+        GtkWidget *parent = gtk_widget_get_parent (item);
+
+        if (GTK_WIDGET_VISIBLE (item)) {
             nvisible++;
-        /* Remove buttons from their parent */
-        if (start_from != -1 && i >= start_from) {
-            GtkWidget *item = GTK_WIDGET (iter->data);
-            GtkWidget *parent = gtk_widget_get_parent (item);
-            if (parent) {
-                g_object_ref (item);
-                gtk_container_remove (GTK_CONTAINER (parent), item);
-            }
+        } else if (parent) {
+            /* The menu owns detached items */
+            g_object_ref (item);
+            gtk_container_remove (GTK_CONTAINER (parent), item);
+            changed = TRUE;
         }
-        i++;
     }
 
-    /* If items have been removed, recalculate the size of the menu */
-    if (start_from != -1)
-        gtk_window_resize (GTK_WINDOW (menu), 1, 1);
-
-    /* Set the final size now to avoid unnecessary resizes later */
-    if (nvisible > 0)
-        gtk_table_resize (priv->table, ((nvisible - 1) / priv->columns) + 1, priv->columns);
-
-    /* Add buttons */
+    /* Move or attach the visible items */
     row = col = 0;
     for (iter = priv->buttons; iter != NULL; iter = iter->next) {
         GtkWidget *item = GTK_WIDGET (iter->data);
-        if (GTK_WIDGET_VISIBLE (item)) {
-            /* Don't add an item to the table if it's already there */
-            if (gtk_widget_get_parent (item) == NULL) {
-                gtk_table_attach_defaults (priv->table, item, col, col + 1, row, row + 1);
-                g_object_unref (item);
-                /* GtkButton must be realized for accelerators to work */
-                gtk_widget_realize (item);
+        GtkWidget *parent;
+
+        if (!GTK_WIDGET_VISIBLE (item))
+            continue;
+
+        parent = gtk_widget_get_parent (item);
+
+        if (parent == GTK_WIDGET (table)) {
+            guint left, top;
+
+            gtk_container_child_get (table, item,
+                                     "left-attach", &left,
+                                     "top-attach", &top, NULL);
+            if (left != col || top != row) {
+                gtk_container_child_set (table, item,
+                                         "left-attach", col,
+                                         "right-attach", col + 1,
+                                         "top-attach", row,
+                                         "bottom-attach", row + 1, NULL);
+                changed = TRUE;
             }
-            if (++col == priv->columns) {
-                col = 0;
-                row++;
+        } else {
+            if (parent) {
+                g_object_ref (item);
+                gtk_container_remove (GTK_CONTAINER (parent), item);
             }
+            gtk_table_attach_defaults (priv->table, item, col, col + 1, row, row + 1);
+            /* The table takes over the reference of the menu */
+            g_object_unref (item);
+            /* GtkButton must be realized for accelerators to work */
+            gtk_widget_realize (item);
+            changed = TRUE;
+        }
+
+        if (++col == priv->columns) {
+            col = 0;
+            row++;
         }
     }
 
-    gtk_widget_queue_draw (GTK_WIDGET (menu));
+    /* Shrink the table to the cells in use. If it lost rows or columns,
+     * let the window shrink too */
+    nrows = nvisible > 0 ? ((nvisible - 1) / priv->columns) + 1 : 1;
+    if (nrows != priv->table->nrows || priv->columns != priv->table->ncols) {
+        if (nrows < priv->table->nrows || priv->columns < priv->table->ncols)
+            gtk_window_resize (GTK_WINDOW (menu), 1, 1);
+        gtk_table_resize (priv->table, nrows, priv->columns);
+        changed = TRUE;
+    }
+
+    if (changed)
+        gtk_widget_queue_draw (GTK_WIDGET (menu));
+}
+
+static gboolean
+hildon_app_menu_relayout_idle                   (gpointer data)
+{
+    HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (data);
+
+    priv->relayout_idle_id = 0;
+    hildon_app_menu_flush_relayout (HILDON_APP_MENU (data));
+
+    return FALSE;
+}
+
+/*
+ * Layout changes are coalesced and applied once per main loop
+ * iteration, before GTK+ resizes and redraws the menu.
+ */
+static void
+hildon_app_menu_queue_relayout                  (HildonAppMenu *menu,
+                                                 gboolean       items,
+                                                 gboolean       filters)
+{
+    HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
+
+    priv->items_dirty |= items;
+    priv->filters_dirty |= filters;
+
+    if (priv->relayout_idle_id == 0)
+        priv->relayout_idle_id = gdk_threads_add_idle_full (G_PRIORITY_HIGH_IDLE,
+                                                            hildon_app_menu_relayout_idle,
+                                                            menu, NULL);
+}
+
+/* Applies a pending relayout right away */
+static void
+hildon_app_menu_flush_relayout                  (HildonAppMenu *menu)
+{
+    HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
+
+    if (priv->relayout_idle_id) {
+        g_source_remove (priv->relayout_idle_id);
+        priv->relayout_idle_id = 0;
+    }
+
+    if (priv->items_dirty) {
+        priv->items_dirty = FALSE;
+        hildon_app_menu_repack_items (menu);
+    }
+
+    if (priv->filters_dirty) {
+        priv->filters_dirty = FALSE;
+        hildon_app_menu_repack_filters (menu);
+    }
 }
 
 /**
@@ -884,7 +1022,14 @@ hildon_app_menu_popup                           (HildonAppMenu *menu,
     g_return_if_fail (GTK_IS_WINDOW (parent_window));
 
     if (hildon_app_menu_has_visible_children (menu)) {
+        HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
         GtkWindowGroup *group;
+
+        if (!GTK_WIDGET_VISIBLE (menu)) {
+            g_get_current_time (&priv->popup_time);
+            priv->popup_pending = TRUE;
+        }
+
         hildon_app_menu_set_parent_window (menu, parent_window);
         group = gtk_window_get_group (parent_window);
         gtk_window_group_add_window (group, GTK_WINDOW (menu));
@@ -893,6 +1038,80 @@ hildon_app_menu_popup                           (HildonAppMenu *menu,
 
 }
 
+/**
+ * hildon_app_menu_get_popup_stats:
+ * @menu: a #HildonAppMenu
+ * @n_popups: return location for the number of popups measured, or %NULL
+ * @last_latency: return location for the latency of the last popup,
+ * or %NULL
+ * @max_latency: return location for the highest popup latency, or %NULL
+ *
+ * Debugging statistics about the time it takes @menu to appear. The
+ * latency of a popup is the time from the call to
+ * hildon_app_menu_popup() to the first time the menu is drawn, in
+ * microseconds.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_app_menu_get_popup_stats                 (HildonAppMenu *menu,
+                                                 guint         *n_popups,
+                                                 guint         *last_latency,
+                                                 guint         *max_latency)
+{
+    HildonAppMenuPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_APP_MENU (menu));
+
+    priv = HILDON_APP_MENU_GET_PRIVATE (menu);
+
+    if (n_popups)
+        *n_popups = priv->n_popups;
+    if (last_latency)
+        *last_latency = priv->last_popup_latency;
+    if (max_latency)
+        *max_latency = priv->max_popup_latency;
+}
+
+static gboolean
+hildon_app_menu_prepare_idle                    (gpointer data)
+{
+    HildonAppMenu *menu = HILDON_APP_MENU (data);
+    HildonAppMenuPrivate *priv = HILDON_APP_MENU_GET_PRIVATE (menu);
+    GtkRequisition requisition;
+
+    priv->prepare_idle_id = 0;
+
+    /* Realizing applies the style; the size request is kept by GTK+
+     * until the contents of the menu change */
+    hildon_app_menu_flush_relayout (menu);
+    gtk_widget_realize (GTK_WIDGET (menu));
+    gtk_widget_size_request (GTK_WIDGET (menu), &requisition);
+
+    return FALSE;
+}
+
+/*
+ * Called when the menu is attached to a window or a program. Does the
+ * work of the first popup (realizing, applying the style, computing the
+ * layout and the size) while the application is idle, so popping the
+ * menu up only needs to map it.
+ */
+void G_GNUC_INTERNAL
+hildon_app_menu_prepare                         (HildonAppMenu *menu)
+{
+    HildonAppMenuPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_APP_MENU (menu));
+
+    priv = HILDON_APP_MENU_GET_PRIVATE (menu);
+
+    if (priv->prepare_idle_id == 0 && !GTK_WIDGET_REALIZED (menu))
+        priv->prepare_idle_id = gdk_threads_add_idle_full (G_PRIORITY_LOW,
+                                                           hildon_app_menu_prepare_idle,
+                                                           menu, NULL);
+}
+
 /**
  * hildon_app_menu_get_items:
  * @menu: a #HildonAppMenu
@@ -956,6 +1175,14 @@ hildon_app_menu_init                            (HildonAppMenu *menu)
     priv->width_request = -1;
     priv->find_intruder_idle_id = 0;
     priv->hide_idle_id = 0;
+    priv->relayout_idle_id = 0;
+    priv->items_dirty = FALSE;
+    priv->filters_dirty = FALSE;
+    priv->prepare_idle_id = 0;
+    priv->popup_pending = FALSE;
+    priv->n_popups = 0;
+    priv->last_popup_latency = 0;
+    priv->max_popup_latency = 0;
 
     /* Create boxes and tables */
     priv->filters_hbox = GTK_BOX (gtk_hbox_new (TRUE, 0));
@@ -1015,6 +1242,16 @@ hildon_app_menu_finalize                        (GObject *object)
         priv->hide_idle_id = 0;
     }
 
+    if (priv->relayout_idle_id) {
+        g_source_remove (priv->relayout_idle_id);
+        priv->relayout_idle_id = 0;
+    }
+
+    if (priv->prepare_idle_id) {
+        g_source_remove (priv->prepare_idle_id);
+        priv->prepare_idle_id = 0;
+    }
+
     if (priv->parent_window) {
         g_signal_handlers_disconnect_by_func (priv->parent_window, parent_window_topmost_notify, object);
         g_signal_handlers_disconnect_by_func (priv->parent_window, parent_window_unmapped, object);
@@ -1043,6 +1280,8 @@ hildon_app_menu_class_init                      (HildonAppMenuClass *klass)
     gobject_class->finalize = hildon_app_menu_finalize;
     widget_class->show_all = hildon_app_menu_show_all;
     widget_class->hide_all = hildon_app_menu_hide_all;
+    widget_class->show = hildon_app_menu_show;
+    widget_class->expose_event = hildon_app_menu_expose;
     widget_class->map = hildon_app_menu_map;
     widget_class->realize = hildon_app_menu_realize;
     widget_class->unrealize = hildon_app_menu_unrealize;
@@ -98,6 +98,12 @@ hildon_app_menu_get_items                       (HildonAppMenu *menu);
 GList *
 hildon_app_menu_get_filters                     (HildonAppMenu *menu);
 
+void
+hildon_app_menu_get_popup_stats                 (HildonAppMenu *menu,
+                                                 guint         *n_popups,
+                                                 guint         *last_latency,
+                                                 guint         *max_latency);
+
 G_END_DECLS
 
 #endif /* __HILDON_APP_MENU_H__ */
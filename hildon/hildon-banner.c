@@ -116,7 +116,8 @@ enum
     PROP_0,
     PROP_PARENT_WINDOW, 
     PROP_IS_TIMED,
-    PROP_TIMEOUT
+    PROP_TIMEOUT,
+    PROP_UPDATE_INTERVAL
 };
 
 static GtkWidget*                               global_timed_banner = NULL;
@@ -124,7 +125,7 @@ static GtkWidget*                               global_timed_banner = NULL;
 static GQuark 
 hildon_banner_timed_quark                       (void);
 
-static void 
+static gboolean
 hildon_banner_bind_style                        (HildonBanner *self);
 
 static gboolean 
@@ -174,7 +175,7 @@ static gboolean
 hildon_banner_map_event                         (GtkWidget *widget, 
                                                  GdkEventAny *event);
 
-static void 
+static gboolean
 force_to_wrap_truncated                         (HildonBanner *banner);
 
 static void
@@ -230,6 +231,19 @@ struct                                          _HildonBannerPrivate
     guint        is_timed             : 1;
     guint        require_override_dnd : 1;
     guint        overrides_dnd        : 1;
+
+    /* Layouts used to measure the text, one per width class (progress
+     * and timed), and the width the label was last measured against */
+    PangoLayout *measure_layouts[2];
+    gint         measured_width;
+
+    /* Coalescing of text updates, see hildon_banner_set_update_interval() */
+    guint        update_interval;
+    guint        update_id;
+    gchar       *pending_text;
+    guint        pending_is_markup    : 1;
+    guint        n_updates_submitted;
+    guint        n_updates_applied;
 };
 
 static GQuark 
@@ -243,8 +257,9 @@ hildon_banner_timed_quark                       (void)
     return quark;
 }
 
-/* Set the widget and label name to make the correct rc-style attached into them */
-static void 
+/* Set the widget and label name to make the correct rc-style attached
+ * into them. Returns TRUE if any of the names changed */
+static gboolean
 hildon_banner_bind_style                  (HildonBanner *self)
 {
     HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (self);
@@ -252,16 +267,27 @@ hildon_banner_bind_style                  (HildonBanner *self)
     gboolean portrait = gdk_screen_get_width (screen) < gdk_screen_get_height (screen);
     const gchar *portrait_suffix = portrait ? "-portrait" : NULL;
     gchar *name;
+    gboolean renamed = FALSE;
 
     g_assert (priv);
 
+    /* Renaming a widget looks its rc style up again, so skip it when
+     * the banner is only being updated */
     name = g_strconcat ("HildonBannerLabel-", priv->name_suffix, NULL);
-    gtk_widget_set_name (priv->label, name);
+    if (strcmp (name, gtk_widget_get_name (priv->label)) != 0) {
+        gtk_widget_set_name (priv->label, name);
+        renamed = TRUE;
+    }
     g_free (name);
 
     name = g_strconcat ("HildonBanner-", priv->name_suffix, portrait_suffix, NULL);
-    gtk_widget_set_name (GTK_WIDGET (self), name);
+    if (strcmp (name, gtk_widget_get_name (GTK_WIDGET (self))) != 0) {
+        gtk_widget_set_name (GTK_WIDGET (self), name);
+        renamed = TRUE;
+    }
     g_free (name);
+
+    return renamed;
 }
 
 /* In timeout function we automatically destroy timed banners */
@@ -367,6 +393,11 @@ hildon_banner_set_property                      (GObject *object,
             priv->is_timed = g_value_get_boolean (value);
             break;
 
+        case PROP_UPDATE_INTERVAL:
+            hildon_banner_set_update_interval (HILDON_BANNER (object),
+                                               g_value_get_uint (value));
+            break;
+
         case PROP_PARENT_WINDOW:
             window = g_value_get_object (value);         
             if (priv->parent) {
@@ -408,6 +439,10 @@ hildon_banner_get_property                      (GObject *object,
             g_value_set_boolean (value, priv->is_timed);
             break;
 
+        case PROP_UPDATE_INTERVAL:
+            g_value_set_uint (value, priv->update_interval);
+            break;
+
         case PROP_PARENT_WINDOW:
             g_value_set_object (value, gtk_window_get_transient_for (GTK_WINDOW (object)));
             break;
@@ -447,6 +482,14 @@ hildon_banner_destroy                           (GtkObject *object)
 
     (void) hildon_banner_clear_timeout (self);
 
+    if (priv->update_id) {
+        g_source_remove (priv->update_id);
+        priv->update_id = 0;
+    }
+
+    g_free (priv->pending_text);
+    priv->pending_text = NULL;
+
     if (GTK_OBJECT_CLASS (hildon_banner_parent_class)->destroy)
         GTK_OBJECT_CLASS (hildon_banner_parent_class)->destroy (object);
 }
@@ -529,16 +572,43 @@ hildon_banner_constructor                       (GType type,
     return banner;
 }
 
+static void
+clear_measure_layouts                           (HildonBanner *banner)
+{
+    HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (priv->measure_layouts); i++) {
+        if (priv->measure_layouts[i]) {
+            g_object_unref (priv->measure_layouts[i]);
+            priv->measure_layouts[i] = NULL;
+        }
+    }
+    priv->measured_width = 0;
+}
+
+/* The measure layouts must follow the font of the label */
+static void
+label_style_set                                 (GtkWidget    *label,
+                                                 GtkStyle     *previous_style,
+                                                 HildonBanner *banner)
+{
+    clear_measure_layouts (banner);
+}
+
 static void
 hildon_banner_dispose                           (GObject *object)
 {
     HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (object);
 
     if (priv->label) {
+        g_signal_handlers_disconnect_by_func (priv->label, label_style_set, object);
         g_object_unref (priv->label);
         priv->label = NULL;
     }
 
+    clear_measure_layouts (HILDON_BANNER (object));
+
     G_OBJECT_CLASS (hildon_banner_parent_class)->dispose (object);
 }
 
@@ -607,52 +677,145 @@ hildon_banner_map_event                         (GtkWidget *widget,
     return result;
 }  
 
-static void
+static gint
+get_max_label_width                             (HildonBanner *banner)
+{
+    HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
+
+    return priv->is_timed ? HILDON_BANNER_LABEL_MAX_TIMED
+        : HILDON_BANNER_LABEL_MAX_PROGRESS;
+}
+
+/* Returns TRUE if the size of the label changed */
+static gboolean
 banner_do_set_text                              (HildonBanner *banner,
                                                  const gchar  *text,
                                                  gboolean      is_markup)
 {
     HildonBannerPrivate *priv;
-    GtkRequisition req;
+    GtkLabel *label;
 
     priv = HILDON_BANNER_GET_PRIVATE (banner);
+    label = GTK_LABEL (priv->label);
+
+    /* Nothing to measure or redraw if neither the text nor the space
+     * available for it changed */
+    if (!is_markup == !gtk_label_get_use_markup (label) &&
+        text != NULL && strcmp (text, gtk_label_get_label (label)) == 0 &&
+        priv->measured_width == get_max_label_width (banner))
+        return FALSE;
 
     if (is_markup) {
-        gtk_label_set_markup (GTK_LABEL (priv->label), text);
+        gtk_label_set_markup (label, text);
     } else {
-        gtk_label_set_text (GTK_LABEL (priv->label), text);
+        gtk_label_set_text (label, text);
     }
-    gtk_widget_set_size_request (priv->label, -1, -1);
-    gtk_widget_size_request (priv->label, &req);
+    priv->n_updates_applied++;
 
-    force_to_wrap_truncated (banner);
+    return force_to_wrap_truncated (banner);
+}
+
+static gboolean
+banner_update_timeout                           (gpointer data)
+{
+    HildonBanner *banner = HILDON_BANNER (data);
+    HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
+    gchar *text;
+
+    /* Nothing arrived during the last interval: stop throttling */
+    if (priv->pending_text == NULL) {
+        priv->update_id = 0;
+        return FALSE;
+    }
+
+    text = priv->pending_text;
+    priv->pending_text = NULL;
+
+    if (banner_do_set_text (banner, text, priv->pending_is_markup) &&
+        GTK_WIDGET_VISIBLE (banner))
+        reshow_banner (banner);
+
+    g_free (text);
+
+    return TRUE;
+}
+
+/* Sets the text right away, or keeps it for the end of the current
+ * update interval, when only the last text submitted is applied.
+ * Returns TRUE if the size of the label changed */
+static gboolean
+banner_submit_text                              (HildonBanner *banner,
+                                                 const gchar  *text,
+                                                 gboolean      is_markup)
+{
+    HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
+
+    priv->n_updates_submitted++;
+
+    if (priv->update_id != 0) {
+        g_free (priv->pending_text);
+        priv->pending_text = g_strdup (text);
+        priv->pending_is_markup = is_markup;
+        return FALSE;
+    }
+
+    if (priv->update_interval > 0)
+        priv->update_id = gdk_threads_add_timeout (priv->update_interval,
+                                                   banner_update_timeout, banner);
+
+    return banner_do_set_text (banner, text, is_markup);
+}
+
+/* Returns a layout wrapped like the label would be at @width. There is
+ * one per width class, so switching between timed and progress banners
+ * doesn't throw the cached shaping away */
+static PangoLayout *
+get_measure_layout                              (HildonBanner *banner,
+                                                 gint          width)
+{
+    HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
+    PangoLayout **layout = &priv->measure_layouts[priv->is_timed ? 1 : 0];
+
+    if (*layout == NULL) {
+        *layout = gtk_widget_create_pango_layout (priv->label, NULL);
+        pango_layout_set_wrap (*layout,
+                               gtk_label_get_line_wrap_mode (GTK_LABEL (priv->label)));
+        pango_layout_set_alignment (*layout, PANGO_ALIGN_CENTER);
+    }
+
+    pango_layout_set_width (*layout, width * PANGO_SCALE);
+
+    return *layout;
 }
 
 /* force to wrap truncated label by setting explicit size request
  * see N#27000 and G#329646 */
-static void 
+static gboolean
 force_to_wrap_truncated                         (HildonBanner *banner)
 {
     PangoLayout *layout;
+    GtkLabel *label;
     int lines;
     int width;
     int height = -1;
+    int old_width, old_height;
     PangoRectangle logical;
-    GtkRequisition requisition;
     HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (banner);
 
-    g_return_if_fail (priv);
+    g_return_val_if_fail (priv, FALSE);
 
-    width = priv->is_timed ? HILDON_BANNER_LABEL_MAX_TIMED
-        : HILDON_BANNER_LABEL_MAX_PROGRESS;
+    label = GTK_LABEL (priv->label);
+    width = get_max_label_width (banner);
+    priv->measured_width = width;
 
-    /* Force the label to compute its layout using the maximum
-     * available width rather than its default one.
+    /* Compute the layout the label would get at the maximum available
+     * width, without going through its size request.
      */
-    gtk_widget_set_size_request (priv->label, width, height);
-    gtk_widget_size_request (priv->label, &requisition);
-
-    layout = gtk_label_get_layout (GTK_LABEL (priv->label));
+    layout = get_measure_layout (banner, width);
+    if (gtk_label_get_use_markup (label))
+        pango_layout_set_markup (layout, gtk_label_get_label (label), -1);
+    else
+        pango_layout_set_text (layout, gtk_label_get_text (label), -1);
     pango_layout_get_extents (layout, NULL, &logical);
 
     /* Now get the actual width needed by the pango layout */
@@ -671,8 +834,15 @@ force_to_wrap_truncated                         (HildonBanner *banner)
         height = (PANGO_PIXELS (logical.height) * 3) / lines + 1;
     }
 
-    /* Set the final width/height */
+    /* Set the final width/height. Text updates that fit in the same
+     * box, like most progress updates, don't queue a resize */
+    gtk_widget_get_size_request (priv->label, &old_width, &old_height);
+    if (width == old_width && height == old_height)
+        return FALSE;
+
     gtk_widget_set_size_request (priv->label, width, height);
+
+    return TRUE;
 }
 
 static void
@@ -692,8 +862,8 @@ hildon_banner_realize                           (GtkWidget *widget)
 {
     GdkWindow *gdkwin;
     GdkScreen *screen;
-    GdkAtom atom;
-    guint32 portrait = 1;
+    GdkDisplay *display;
+    glong portrait = 1;
     const gchar *notification_type = "_HILDON_NOTIFICATION_TYPE_BANNER";
     HildonBannerPrivate *priv = HILDON_BANNER_GET_PRIVATE (widget);
     g_assert (priv);
@@ -708,15 +878,18 @@ hildon_banner_realize                           (GtkWidget *widget)
 
     gdkwin = widget->window;
 
+    display = gdk_drawable_get_display (gdkwin);
+
     /* Set the _HILDON_NOTIFICATION_TYPE property so Matchbox places the window correctly */
-    atom = gdk_atom_intern ("_HILDON_NOTIFICATION_TYPE", FALSE);
-    gdk_property_change (gdkwin, atom, gdk_x11_xatom_to_atom (XA_STRING), 8, GDK_PROP_MODE_REPLACE,
-                         (gpointer) notification_type, strlen (notification_type));
+    XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin),
+                     hildon_private_get_xatom (display, HILDON_ATOM_HILDON_NOTIFICATION_TYPE),
+                     XA_STRING, 8, PropModeReplace,
+                     (guchar *) notification_type, strlen (notification_type));
 
     /* HildonBanner supports portrait mode */
-    atom = gdk_atom_intern ("_HILDON_PORTRAIT_MODE_SUPPORT", FALSE);
-    gdk_property_change (gdkwin, atom, gdk_x11_xatom_to_atom (XA_CARDINAL), 32,
-                         GDK_PROP_MODE_REPLACE, (gpointer) &portrait, 1);
+    XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin),
+                     hildon_private_get_xatom (display, HILDON_ATOM_HILDON_PORTRAIT_MODE_SUPPORT),
+                     XA_CARDINAL, 32, PropModeReplace, (guchar *) &portrait, 1);
 
     /* Manage override flag */
     if ((priv->require_override_dnd)&&(!priv->overrides_dnd)) {
@@ -809,6 +982,24 @@ hildon_banner_class_init                        (HildonBannerClass *klass)
                 10000,
                 HILDON_BANNER_DEFAULT_TIMEOUT,
                 G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+    /**
+     * HildonBanner:update-interval:
+     *
+     * Minimum time between two changes of the banner text, in
+     * milliseconds. See hildon_banner_set_update_interval().
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (object_class, PROP_UPDATE_INTERVAL,
+            g_param_spec_uint ("update-interval",
+                "Update interval",
+                "Minimum time between two changes of the banner text, "
+                "or 0 to apply every change",
+                0,
+                G_MAXUINT,
+                0,
+                G_PARAM_READWRITE));
 }
 
 static void 
@@ -837,6 +1028,7 @@ hildon_banner_init                              (HildonBanner *self)
     gtk_container_add (GTK_CONTAINER (priv->alignment), priv->layout);
     g_object_ref (priv->label);
     gtk_box_pack_start (GTK_BOX (priv->layout), priv->label, FALSE, FALSE, 0);
+    g_signal_connect (priv->label, "style-set", G_CALLBACK (label_style_set), self);
 
     gtk_window_set_accept_focus (GTK_WINDOW (self), FALSE);
 
@@ -945,15 +1137,13 @@ hildon_banner_show_information_override_dnd     (GtkWidget *widget,
 static void
 hildon_banner_set_override_flag                 (HildonBanner *banner)
 {
-    guint32 state = 1;
-
-    gdk_property_change (GTK_WIDGET (banner)->window,
-                         gdk_atom_intern_static_string ("_HILDON_DO_NOT_DISTURB_OVERRIDE"),
-                         gdk_x11_xatom_to_atom (XA_INTEGER),
-                         32,
-                         GDK_PROP_MODE_REPLACE,
-                         (const guchar*) &state,
-                         1);
+    GdkWindow *gdkwin = GTK_WIDGET (banner)->window;
+    glong state = 1;
+
+    XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin),
+                     hildon_private_get_xatom (gdk_drawable_get_display (gdkwin),
+                                               HILDON_ATOM_HILDON_DO_NOT_DISTURB_OVERRIDE),
+                     XA_INTEGER, 32, PropModeReplace, (guchar *) &state, 1);
 }
 
 static void
@@ -965,7 +1155,8 @@ reshow_banner                                   (HildonBanner *banner)
     gtk_widget_show_all (GTK_WIDGET (banner));
 }
 
-static void
+/* Returns TRUE if the label had to be packed back */
+static gboolean
 unpack_main_widget_pack_label                   (HildonBanner *banner)
 {
     HildonBannerPrivate *priv = NULL;
@@ -977,7 +1168,10 @@ unpack_main_widget_pack_label                   (HildonBanner *banner)
         priv->main_item = NULL;
         gtk_box_pack_start (GTK_BOX (priv->layout), priv->label, FALSE, FALSE,
                             0);
+        return TRUE;
     }
+
+    return FALSE;
 }
 
 static GtkWidget*
@@ -987,6 +1181,7 @@ hildon_banner_real_show_information             (GtkWidget *widget,
 {
     HildonBanner *banner;
     HildonBannerPrivate *priv = NULL;
+    gboolean changed;
 
     g_return_val_if_fail (text != NULL, NULL);
 
@@ -995,17 +1190,19 @@ hildon_banner_real_show_information             (GtkWidget *widget,
     priv = HILDON_BANNER_GET_PRIVATE (banner);
 
     priv->name_suffix = "information";
-    unpack_main_widget_pack_label (banner);
-    banner_do_set_text (banner, text, FALSE);
-    hildon_banner_bind_style (banner);
+    changed = unpack_main_widget_pack_label (banner);
+    changed |= banner_submit_text (banner, text, FALSE);
+    changed |= hildon_banner_bind_style (banner);
 
     if (override_dnd) {
       /* so on the realize it will set the property */
       priv->require_override_dnd = TRUE;
     }
 
-    /* Show the banner, since caller cannot do that */
-    reshow_banner (banner);
+    /* Show the banner, since caller cannot do that. A banner already on
+     * screen with the same geometry only needs its label redrawn */
+    if (changed || !GTK_WIDGET_VISIBLE (banner))
+        reshow_banner (banner);
 
     return GTK_WIDGET (banner);
 }
@@ -1070,6 +1267,7 @@ hildon_banner_show_information_with_markup      (GtkWidget *widget,
 {
     HildonBanner *banner;
     HildonBannerPrivate *priv;
+    gboolean changed;
 
     g_return_val_if_fail (icon_name == NULL || icon_name[0] != 0, NULL);
     g_return_val_if_fail (markup != NULL, NULL);
@@ -1079,11 +1277,12 @@ hildon_banner_show_information_with_markup      (GtkWidget *widget,
     priv = HILDON_BANNER_GET_PRIVATE (banner);
 
     priv->name_suffix = "information";
-    banner_do_set_text (banner, markup, TRUE);
-    hildon_banner_bind_style (banner);
+    changed = banner_submit_text (banner, markup, TRUE);
+    changed |= hildon_banner_bind_style (banner);
 
     /* Show the banner, since caller cannot do that */
-    reshow_banner (banner);
+    if (changed || !GTK_WIDGET_VISIBLE (banner))
+        reshow_banner (banner);
 
     return (GtkWidget *) banner;
 }
@@ -1146,7 +1345,7 @@ hildon_banner_show_animation                    (GtkWidget *widget,
 
     priv = HILDON_BANNER_GET_PRIVATE (banner);
     priv->name_suffix = "animation";
-    banner_do_set_text (banner, text, FALSE);
+    banner_submit_text (banner, text, FALSE);
     hildon_banner_bind_style (banner);
 
     /* And show it */
@@ -1187,7 +1386,7 @@ hildon_banner_show_progress                     (GtkWidget *widget,
 
     priv->name_suffix = "progress";
     unpack_main_widget_pack_label (banner);
-    banner_do_set_text (banner, text, FALSE);
+    banner_submit_text (banner, text, FALSE);
     hildon_banner_bind_style (banner);
 
     if (priv->parent)
@@ -1270,9 +1469,8 @@ hildon_banner_set_text                          (HildonBanner *self,
 {
     g_return_if_fail (HILDON_IS_BANNER (self));
 
-    banner_do_set_text (self, text, FALSE);
-
-    if (GTK_WIDGET_VISIBLE (self))
+    /* Only a change of geometry needs the window to be laid out again */
+    if (banner_submit_text (self, text, FALSE) && GTK_WIDGET_VISIBLE (self))
         reshow_banner (self);
 }
 
@@ -1290,9 +1488,8 @@ hildon_banner_set_markup                        (HildonBanner *self,
 {
     g_return_if_fail (HILDON_IS_BANNER (self));
 
-    banner_do_set_text (self, markup, TRUE);
-
-    if (GTK_WIDGET_VISIBLE (self))
+    /* Only a change of geometry needs the window to be laid out again */
+    if (banner_submit_text (self, markup, TRUE) && GTK_WIDGET_VISIBLE (self))
         reshow_banner (self);
 }
 
@@ -1344,6 +1541,86 @@ hildon_banner_set_timeout                       (HildonBanner *self,
     priv->timeout = timeout;
 }
 
+/**
+ * hildon_banner_set_update_interval:
+ * @self: a #HildonBanner widget
+ * @interval: minimum time between two text updates, in milliseconds,
+ * or 0 to apply every update
+ *
+ * Limits how often the text of @self is changed. When an interval is
+ * set, the first update is applied right away and the ones submitted
+ * during the following @interval milliseconds are collapsed into the
+ * last one, which is applied when the interval ends. This is meant for
+ * callers that report progress from a loop using
+ * hildon_banner_set_text() or hildon_banner_show_information(); an
+ * interval of about 16 milliseconds applies at most one update per
+ * frame.
+ *
+ * Setting a new interval applies any pending update immediately.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_banner_set_update_interval               (HildonBanner *self,
+                                                 guint         interval)
+{
+    HildonBannerPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_BANNER (self));
+    priv = HILDON_BANNER_GET_PRIVATE (self);
+
+    if (priv->update_interval == interval)
+        return;
+
+    priv->update_interval = interval;
+
+    if (priv->update_id) {
+        g_source_remove (priv->update_id);
+        priv->update_id = 0;
+
+        if (priv->pending_text) {
+            gchar *text = priv->pending_text;
+            priv->pending_text = NULL;
+            if (banner_do_set_text (self, text, priv->pending_is_markup) &&
+                GTK_WIDGET_VISIBLE (self))
+                reshow_banner (self);
+            g_free (text);
+        }
+    }
+
+    g_object_notify (G_OBJECT (self), "update-interval");
+}
+
+/**
+ * hildon_banner_get_update_stats:
+ * @self: a #HildonBanner widget
+ * @n_submitted: return location for the number of text updates
+ * submitted, or %NULL
+ * @n_applied: return location for the number of text updates
+ * actually applied to the label, or %NULL
+ *
+ * Debugging statistics about the text updates of @self. Updates that
+ * are collapsed because of the #HildonBanner:update-interval, or that
+ * don't change the text, are submitted but not applied.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_banner_get_update_stats                  (HildonBanner *self,
+                                                 guint        *n_submitted,
+                                                 guint        *n_applied)
+{
+    HildonBannerPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_BANNER (self));
+    priv = HILDON_BANNER_GET_PRIVATE (self);
+
+    if (n_submitted)
+        *n_submitted = priv->n_updates_submitted;
+    if (n_applied)
+        *n_applied = priv->n_updates_applied;
+}
+
 /**
  * hildon_banner_set_icon:
  * @self: a #HildonBanner widget
@@ -119,6 +119,15 @@ GtkWidget *
 hildon_banner_show_custom_widget                (GtkWidget *widget,
                                                  GtkWidget *custom_widget);
 
+void
+hildon_banner_set_update_interval               (HildonBanner *self,
+                                                 guint interval);
+
+void
+hildon_banner_get_update_stats                  (HildonBanner *self,
+                                                 guint *n_submitted,
+                                                 guint *n_applied);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_BANNER_H__ */
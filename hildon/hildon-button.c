@@ -51,6 +51,14 @@
  * If only one label is needed, #GtkButton can be used as well, see
  * also hildon_gtk_button_new().
  *
+ * Applications showing a large number of buttons can create them with
+ * the #HildonButton:lightweight property set to %TRUE. Lightweight
+ * buttons draw their labels and image themselves instead of using
+ * child widgets, which makes them cheaper to create and to restyle.
+ * As there are no labels for assistive technologies to read, the
+ * accessible name of a lightweight button is set to its title, or to
+ * its value if it has no title.
+ *
  * <example>
  * <title>Creating a HildonButton</title>
  * <programlisting>
@@ -91,6 +99,8 @@
 #include                                        "hildon-button.h"
 #include                                        "hildon-enum-types.h"
 #include                                        "hildon-gtk.h"
+#include                                        "hildon-private.h"
+#include                                        "hildon-size-group.h"
 
 G_DEFINE_TYPE                                   (HildonButton, hildon_button, GTK_TYPE_BUTTON);
 
@@ -112,7 +122,28 @@ struct                                          _HildonButtonPrivate
     gfloat image_xalign;
     gfloat image_yalign;
     HildonButtonStyle style;
+    HildonButtonArrangement arrangement;
     guint setting_style : 1;
+
+    /* Lightweight mode, see HildonButton:lightweight */
+    guint lightweight : 1;
+    guint lightweight_valid : 1;
+    guint accessible_name_set : 1;
+    gchar *title_text;
+    gchar *value_text;
+    PangoLayout *title_layout;
+    PangoLayout *value_layout;
+    GdkPixbuf *image_pixbuf;
+    gfloat title_xalign, title_yalign;
+    gfloat value_xalign, value_yalign;
+    gfloat xscale, yscale;
+    guint label_spacing;
+    guint image_spacing;
+    GdkColor title_colors[5];
+    GdkColor value_colors[5];
+    GdkRectangle title_area;
+    GdkRectangle value_area;
+    GdkRectangle image_area;
 };
 
 enum {
@@ -120,7 +151,8 @@ enum {
     PROP_VALUE,
     PROP_SIZE,
     PROP_ARRANGEMENT,
-    PROP_STYLE
+    PROP_STYLE,
+    PROP_LIGHTWEIGHT
 };
 
 static void
@@ -130,6 +162,9 @@ hildon_button_set_arrangement                   (HildonButton            *button
 static void
 hildon_button_construct_child                   (HildonButton *button);
 
+static void
+hildon_button_leave_lightweight_mode            (HildonButton *button);
+
 static void
 hildon_button_set_property                      (GObject      *object,
                                                  guint         prop_id,
@@ -159,6 +194,9 @@ hildon_button_set_property                      (GObject      *object,
     case PROP_STYLE:
         hildon_button_set_style (button, g_value_get_enum (value));
         break;
+    case PROP_LIGHTWEIGHT:
+        HILDON_BUTTON_GET_PRIVATE (button)->lightweight = g_value_get_boolean (value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -184,6 +222,9 @@ hildon_button_get_property                      (GObject    *object,
     case PROP_STYLE:
         g_value_set_enum (value, hildon_button_get_style (button));
         break;
+    case PROP_LIGHTWEIGHT:
+        g_value_set_boolean (value, HILDON_BUTTON_GET_PRIVATE (button)->lightweight);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
         break;
@@ -198,19 +239,32 @@ set_logical_font                                (GtkWidget *button)
     /* In buttons with vertical arrangement, the 'value' label uses a
      * different font */
     if (GTK_IS_VBOX (priv->label_box)) {
-        GtkStyle *style = gtk_rc_get_style_by_paths (
-            gtk_settings_get_default (), "SmallSystemFont", NULL, G_TYPE_NONE);
-        if (style != NULL) {
-            PangoFontDescription *font_desc = style->font_desc;
-            if (font_desc != NULL) {
+        const PangoFontDescription *font_desc;
+        font_desc = hildon_private_get_logical_font ("SmallSystemFont");
+        if (font_desc != NULL) {
+            GtkRcStyle *rc_style = gtk_widget_get_modifier_style (GTK_WIDGET (priv->value));
+            if (hildon_private_modifier_set_font (rc_style, font_desc)) {
                 priv->setting_style = TRUE;
-                gtk_widget_modify_font (GTK_WIDGET (priv->value), font_desc);
+                gtk_widget_modify_style (GTK_WIDGET (priv->value), rc_style);
                 priv->setting_style = FALSE;
             }
         }
     }
 }
 
+static const gchar *
+get_value_color_name                            (HildonButtonStyle style)
+{
+    switch (style) {
+    case HILDON_BUTTON_STYLE_NORMAL:
+        return "SecondaryTextColor";
+    case HILDON_BUTTON_STYLE_PICKER:
+        return "ActiveTextColor";
+    default:
+        g_return_val_if_reached (NULL);
+    }
+}
+
 static void
 set_logical_color                               (GtkWidget *button)
 {
@@ -219,24 +273,576 @@ set_logical_color                               (GtkWidget *button)
     HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
     GtkWidget *label = GTK_WIDGET (priv->value);
 
-    switch (priv->style) {
-    case HILDON_BUTTON_STYLE_NORMAL:
-        colorname = "SecondaryTextColor";
-        break;
-    case HILDON_BUTTON_STYLE_PICKER:
-        colorname = "ActiveTextColor";
-        break;
+    /* Lightweight buttons resolve their colors when drawing */
+    if (label == NULL) {
+        priv->lightweight_valid = FALSE;
+        gtk_widget_queue_draw (button);
+        return;
+    }
+
+    colorname = get_value_color_name (priv->style);
+    if (colorname == NULL)
+        return;
+
+    if (hildon_private_get_logical_color (label, colorname, &color) == TRUE) {
+        GtkRcStyle *rc_style = gtk_widget_get_modifier_style (label);
+        gboolean changed;
+
+        /* Set both states with a single style reset, and none at all
+         * when the label already has this color */
+        changed = hildon_private_modifier_set_color (rc_style, GTK_RC_FG,
+                                                     GTK_STATE_NORMAL, &color);
+        changed |= hildon_private_modifier_set_color (rc_style, GTK_RC_FG,
+                                                      GTK_STATE_PRELIGHT, &color);
+        if (changed) {
+            priv->setting_style = TRUE;
+            gtk_widget_modify_style (label, rc_style);
+            priv->setting_style = FALSE;
+        }
+    }
+}
+
+/* Lightweight mode: the button has no child widgets, and lays out and
+ * draws the title, value and image itself, the same way the default
+ * GtkAlignment, boxes, labels and image would. */
+
+/* Lightweight buttons, and regular ones whose labels are not created
+ * yet because they are still being constructed, keep their texts and
+ * alignments in the private structure */
+static gboolean
+hildon_button_stores_contents                   (HildonButtonPrivate *priv)
+{
+    return priv->lightweight || priv->label_box == NULL;
+}
+
+static gboolean
+lightweight_active                              (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    /* A child added with gtk_container_add() takes over */
+    return priv->lightweight && gtk_bin_get_child (GTK_BIN (button)) == NULL;
+}
+
+/* Looks up the rc style that the title or value label would get */
+static GtkStyle *
+lightweight_get_label_style                     (HildonButton *button,
+                                                 const gchar  *name)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *widget = GTK_WIDGET (button);
+    const gchar *box;
+    gchar *path, *class_path, *label_path, *label_class_path;
+    GtkStyle *style;
+
+    box = priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL ? "GtkVBox" : "GtkHBox";
+
+    gtk_widget_path (widget, NULL, &path, NULL);
+    gtk_widget_class_path (widget, NULL, &class_path, NULL);
+    label_path = g_strconcat (path, ".GtkAlignment.GtkHBox.", box, ".", name, NULL);
+    label_class_path = g_strconcat (class_path, ".GtkAlignment.GtkHBox.", box, ".GtkLabel", NULL);
+
+    style = gtk_rc_get_style_by_paths (gtk_widget_get_settings (widget),
+                                       label_path, label_class_path, GTK_TYPE_LABEL);
+
+    g_free (path);
+    g_free (class_path);
+    g_free (label_path);
+    g_free (label_class_path);
+
+    return style ? style : gtk_widget_get_default_style ();
+}
+
+static GdkPixbuf *
+lightweight_load_image                          (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *widget = GTK_WIDGET (button);
+    GtkImage *image = GTK_IMAGE (priv->image);
+    GtkIconSize size;
+    const gchar *name;
+    gchar *stock_id;
+    gint pixel_size, width, height;
+
+    switch (gtk_image_get_storage_type (image)) {
+    case GTK_IMAGE_PIXBUF:
+        return g_object_ref (gtk_image_get_pixbuf (image));
+    case GTK_IMAGE_STOCK:
+        gtk_image_get_stock (image, &stock_id, &size);
+        return gtk_widget_render_icon (widget, stock_id, size, NULL);
+    case GTK_IMAGE_ICON_NAME:
+        gtk_image_get_icon_name (image, &name, &size);
+        g_object_get (image, "pixel-size", &pixel_size, NULL);
+        if (pixel_size < 0) {
+            if (!gtk_icon_size_lookup_for_settings (gtk_widget_get_settings (widget),
+                                                    size, &width, &height))
+                return NULL;
+            pixel_size = MIN (width, height);
+        }
+        return gtk_icon_theme_load_icon (gtk_icon_theme_get_for_screen (gtk_widget_get_screen (widget)),
+                                         name, pixel_size, 0, NULL);
     default:
-        g_return_if_reached ();
+        return NULL;
+    }
+}
+
+static gboolean
+lightweight_can_draw_image                      (GtkWidget *image)
+{
+    if (!GTK_IS_IMAGE (image))
+        return FALSE;
+
+    switch (gtk_image_get_storage_type (GTK_IMAGE (image))) {
+    case GTK_IMAGE_EMPTY:
+    case GTK_IMAGE_PIXBUF:
+    case GTK_IMAGE_STOCK:
+    case GTK_IMAGE_ICON_NAME:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+/* Resolves everything that depends on the style of the button, once
+ * after each change */
+static void
+lightweight_ensure                              (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *widget = GTK_WIDGET (button);
+    GtkStyle *title_style, *value_style;
+    const PangoFontDescription *value_font;
+    const gchar *colorname;
+    GdkColor color;
+    gint state;
+
+    if (priv->lightweight_valid)
+        return;
+
+    if (priv->title_layout == NULL) {
+        priv->title_layout = gtk_widget_create_pango_layout (widget, priv->title_text);
+        priv->value_layout = gtk_widget_create_pango_layout (widget, priv->value_text);
+    } else {
+        pango_layout_context_changed (priv->title_layout);
+        pango_layout_context_changed (priv->value_layout);
+    }
+
+    title_style = lightweight_get_label_style (button, "hildon-button-title");
+    value_style = lightweight_get_label_style (button, "hildon-button-value");
+
+    value_font = value_style->font_desc;
+    if (priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL) {
+        const PangoFontDescription *small_font;
+        small_font = hildon_private_get_logical_font ("SmallSystemFont");
+        if (small_font != NULL)
+            value_font = small_font;
     }
 
-    gtk_widget_ensure_style (label);
-    if (gtk_style_lookup_color (label->style, colorname, &color) == TRUE) {
-        priv->setting_style = TRUE;
-        gtk_widget_modify_fg (label, GTK_STATE_NORMAL, &color);
-        gtk_widget_modify_fg (label, GTK_STATE_PRELIGHT, &color);
-        priv->setting_style = FALSE;
+    pango_layout_set_font_description (priv->title_layout, title_style->font_desc);
+    pango_layout_set_font_description (priv->value_layout, value_font);
+
+    for (state = GTK_STATE_NORMAL; state <= GTK_STATE_INSENSITIVE; state++) {
+        priv->title_colors[state] = title_style->fg[state];
+        priv->value_colors[state] = value_style->fg[state];
+    }
+
+    colorname = get_value_color_name (priv->style);
+    if (colorname != NULL && hildon_private_get_logical_color (widget, colorname, &color)) {
+        priv->value_colors[GTK_STATE_NORMAL] = color;
+        priv->value_colors[GTK_STATE_PRELIGHT] = color;
+    }
+
+    gtk_widget_style_get (widget,
+                          priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL ?
+                          "vertical-spacing" : "horizontal-spacing", &priv->label_spacing,
+                          "image-spacing", &priv->image_spacing,
+                          NULL);
+
+    if (priv->image_pixbuf) {
+        g_object_unref (priv->image_pixbuf);
+        priv->image_pixbuf = NULL;
+    }
+    if (priv->image)
+        priv->image_pixbuf = lightweight_load_image (button);
+
+    priv->lightweight_valid = TRUE;
+}
+
+static void
+lightweight_get_label_size                      (PangoLayout *layout,
+                                                 const gchar *text,
+                                                 gint        *width,
+                                                 gint        *height)
+{
+    PangoRectangle logical;
+
+    /* Labels without text are hidden */
+    if (text == NULL || text[0] == '\0') {
+        *width = *height = 0;
+        return;
+    }
+
+    pango_layout_get_pixel_extents (layout, NULL, &logical);
+    *width = logical.width;
+    *height = logical.height;
+}
+
+/* Size of the label box, with the spacing only between visible labels */
+static void
+lightweight_get_label_box_size                  (HildonButton *button,
+                                                 gint         *width,
+                                                 gint         *height)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    gint title_width, title_height, value_width, value_height;
+    gint spacing;
+
+    lightweight_get_label_size (priv->title_layout, priv->title_text, &title_width, &title_height);
+    lightweight_get_label_size (priv->value_layout, priv->value_text, &value_width, &value_height);
+
+    spacing = (title_width && value_width) ? priv->label_spacing : 0;
+
+    if (priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL) {
+        *width = MAX (title_width, value_width);
+        *height = title_height + spacing + value_height;
+    } else {
+        *width = title_width + spacing + value_width;
+        *height = MAX (title_height, value_height);
+    }
+}
+
+static void
+lightweight_size_request                        (HildonButton   *button,
+                                                 GtkRequisition *requisition)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    gint width, height;
+
+    lightweight_ensure (button);
+    lightweight_get_label_box_size (button, &width, &height);
+
+    if (priv->image) {
+        gint image_width = 0, image_height = 0;
+        if (priv->image_pixbuf) {
+            image_width = gdk_pixbuf_get_width (priv->image_pixbuf);
+            image_height = gdk_pixbuf_get_height (priv->image_pixbuf);
+        }
+        width += image_width + priv->image_spacing;
+        height = MAX (height, image_height);
+    }
+
+    requisition->width += width;
+    requisition->height += height;
+}
+
+/* The area GtkButton would allocate to its child */
+static void
+lightweight_get_content_area                    (HildonButton *button,
+                                                 GdkRectangle *area)
+{
+    GtkWidget *widget = GTK_WIDGET (button);
+    GtkBorder default_border = { 1, 1, 1, 1 };
+    GtkBorder inner_border = { 1, 1, 1, 1 };
+    GtkBorder *border;
+    gint border_width = GTK_CONTAINER (widget)->border_width;
+    gint focus_width, focus_pad;
+
+    gtk_widget_style_get (widget,
+                          "focus-line-width", &focus_width,
+                          "focus-padding", &focus_pad,
+                          NULL);
+
+    gtk_widget_style_get (widget, "inner-border", &border, NULL);
+    if (border) {
+        inner_border = *border;
+        gtk_border_free (border);
+    }
+
+    area->x = widget->allocation.x + border_width + inner_border.left + widget->style->xthickness;
+    area->y = widget->allocation.y + border_width + inner_border.top + widget->style->ythickness;
+    area->width = widget->allocation.width - widget->style->xthickness * 2 -
+        inner_border.left - inner_border.right - border_width * 2;
+    area->height = widget->allocation.height - widget->style->ythickness * 2 -
+        inner_border.top - inner_border.bottom - border_width * 2;
+
+    if (GTK_WIDGET_CAN_DEFAULT (widget)) {
+        gtk_widget_style_get (widget, "default-border", &border, NULL);
+        if (border) {
+            default_border = *border;
+            gtk_border_free (border);
+        }
+        area->x += default_border.left;
+        area->y += default_border.top;
+        area->width -= default_border.left + default_border.right;
+        area->height -= default_border.top + default_border.bottom;
+    }
+
+    if (GTK_WIDGET_CAN_FOCUS (widget)) {
+        area->x += focus_width + focus_pad;
+        area->y += focus_width + focus_pad;
+        area->width -= 2 * (focus_width + focus_pad);
+        area->height -= 2 * (focus_width + focus_pad);
+    }
+
+    if (GTK_BUTTON (widget)->depressed) {
+        gint child_displacement_x, child_displacement_y;
+        gtk_widget_style_get (widget,
+                              "child-displacement-x", &child_displacement_x,
+                              "child-displacement-y", &child_displacement_y,
+                              NULL);
+        area->x += child_displacement_x;
+        area->y += child_displacement_y;
+    }
+
+    area->width = MAX (1, area->width);
+    area->height = MAX (1, area->height);
+}
+
+/* Places a box child of size @size at @offset along @box, mirrored in
+ * right-to-left locales like GtkBox does */
+static gint
+lightweight_box_position                        (GtkWidget          *widget,
+                                                 const GdkRectangle *box,
+                                                 gint                offset,
+                                                 gint                size)
+{
+    if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
+        return box->x + box->width - offset - size;
+
+    return box->x + offset;
+}
+
+static void
+lightweight_size_allocate                       (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *widget = GTK_WIDGET (button);
+    GdkRectangle area, contents, labels;
+    gint label_box_width, label_box_height;
+    gint title_width, title_height, value_width, value_height;
+    gint image_width = 0, offset = 0, spacing;
+    GtkRequisition requisition = { 0, 0 };
+    gfloat xalign, yalign;
+
+    lightweight_ensure (button);
+    lightweight_get_content_area (button, &area);
+
+    /* The GtkAlignment */
+    lightweight_size_request (button, &requisition);
+    gtk_button_get_alignment (GTK_BUTTON (button), &xalign, &yalign);
+
+    contents.width = area.width;
+    if (area.width > requisition.width)
+        contents.width = requisition.width + priv->xscale * (area.width - requisition.width);
+    contents.height = area.height;
+    if (area.height > requisition.height)
+        contents.height = requisition.height + priv->yscale * (area.height - requisition.height);
+    if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
+        xalign = 1.0 - xalign;
+    contents.x = area.x + xalign * (area.width - contents.width);
+    contents.y = area.y + yalign * (area.height - contents.height);
+
+    /* The box with the image and the labels, which get the extra space */
+    if (priv->image_pixbuf)
+        image_width = gdk_pixbuf_get_width (priv->image_pixbuf);
+    lightweight_get_label_box_size (button, &label_box_width, &label_box_height);
+
+    labels.y = contents.y;
+    labels.height = contents.height;
+    labels.width = contents.width;
+    if (priv->image)
+        labels.width = MAX (0, contents.width - image_width - (gint) priv->image_spacing);
+
+    if (priv->image && priv->image_position == GTK_POS_LEFT) {
+        offset = image_width + priv->image_spacing;
+        priv->image_area.x = lightweight_box_position (widget, &contents, 0, image_width);
+    } else if (priv->image) {
+        priv->image_area.x = lightweight_box_position (widget, &contents,
+                                                       labels.width + priv->image_spacing,
+                                                       image_width);
+    }
+    priv->image_area.y = contents.y;
+    priv->image_area.width = image_width;
+    priv->image_area.height = contents.height;
+    labels.x = lightweight_box_position (widget, &contents, offset, labels.width);
+
+    /* The labels, the value one gets the extra space */
+    lightweight_get_label_size (priv->title_layout, priv->title_text, &title_width, &title_height);
+    lightweight_get_label_size (priv->value_layout, priv->value_text, &value_width, &value_height);
+    spacing = (title_width && value_width) ? priv->label_spacing : 0;
+
+    if (priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL) {
+        priv->title_area.x = priv->value_area.x = labels.x;
+        priv->title_area.width = priv->value_area.width = labels.width;
+        priv->title_area.y = labels.y;
+        priv->title_area.height = title_height;
+        priv->value_area.y = labels.y + title_height + spacing;
+        priv->value_area.height = MAX (0, labels.height - title_height - spacing);
+    } else {
+        priv->title_area.y = priv->value_area.y = labels.y;
+        priv->title_area.height = priv->value_area.height = labels.height;
+        priv->title_area.width = title_width;
+        priv->value_area.width = MAX (0, labels.width - title_width - spacing);
+        priv->title_area.x = lightweight_box_position (widget, &labels, 0, title_width);
+        priv->value_area.x = lightweight_box_position (widget, &labels, title_width + spacing,
+                                                       priv->value_area.width);
+    }
+}
+
+/* Draws a label like GtkLabel does in its allocation */
+static void
+lightweight_draw_label                          (HildonButton       *button,
+                                                 GdkEventExpose     *event,
+                                                 PangoLayout        *layout,
+                                                 const GdkRectangle *area,
+                                                 gfloat              xalign,
+                                                 gfloat              yalign,
+                                                 GdkColor           *color)
+{
+    GtkWidget *widget = GTK_WIDGET (button);
+    GdkGC *gc = widget->style->fg_gc[GTK_WIDGET_STATE (widget)];
+    PangoRectangle logical;
+    gint x, y;
+
+    pango_layout_get_pixel_extents (layout, NULL, &logical);
+
+    if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL) {
+        x = area->x + (1.0 - xalign) * (area->width - logical.width);
+        x = MIN (x, area->x + area->width - logical.width);
+    } else {
+        x = area->x + xalign * (area->width - logical.width);
+        x = MAX (x, area->x);
+    }
+    y = area->y + MAX ((area->height - logical.height) * yalign, 0);
+
+    gdk_gc_set_clip_rectangle (gc, &event->area);
+    gdk_draw_layout_with_colors (widget->window, gc, x - logical.x, y, layout, color, NULL);
+    gdk_gc_set_clip_rectangle (gc, NULL);
+}
+
+static void
+lightweight_draw_image                          (HildonButton   *button,
+                                                 GdkEventExpose *event)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *widget = GTK_WIDGET (button);
+    GdkPixbuf *pixbuf = priv->image_pixbuf;
+    GdkRectangle image, draw;
+    gfloat xalign = priv->image_xalign;
+
+    image.width = gdk_pixbuf_get_width (pixbuf);
+    image.height = gdk_pixbuf_get_height (pixbuf);
+    if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
+        xalign = 1.0 - xalign;
+    image.x = priv->image_area.x + (priv->image_area.width - image.width) * xalign;
+    image.y = priv->image_area.y + (priv->image_area.height - image.height) * priv->image_yalign;
+
+    if (!gdk_rectangle_intersect (&event->area, &image, &draw))
+        return;
+
+    /* Same as GtkImage */
+    if (!GTK_WIDGET_IS_SENSITIVE (widget)) {
+        GtkIconSource *source = gtk_icon_source_new ();
+        gtk_icon_source_set_pixbuf (source, pixbuf);
+        gtk_icon_source_set_size (source, GTK_ICON_SIZE_SMALL_TOOLBAR);
+        gtk_icon_source_set_size_wildcarded (source, FALSE);
+        pixbuf = gtk_style_render_icon (widget->style, source,
+                                        gtk_widget_get_direction (widget),
+                                        GTK_WIDGET_STATE (widget),
+                                        -1, widget, "gtk-image");
+        gtk_icon_source_free (source);
+    } else {
+        g_object_ref (pixbuf);
+    }
+
+    gdk_draw_pixbuf (widget->window, NULL, pixbuf,
+                     draw.x - image.x, draw.y - image.y,
+                     draw.x, draw.y, draw.width, draw.height,
+                     GDK_RGB_DITHER_NORMAL, 0, 0);
+
+    g_object_unref (pixbuf);
+}
+
+static void
+lightweight_image_notify                        (GObject      *image,
+                                                 GParamSpec   *pspec,
+                                                 HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    if (lightweight_can_draw_image (GTK_WIDGET (image))) {
+        priv->lightweight_valid = FALSE;
+        gtk_widget_queue_resize (GTK_WIDGET (button));
+    } else {
+        hildon_button_leave_lightweight_mode (button);
+    }
+}
+
+static void
+lightweight_alignment_notify                    (GObject    *button,
+                                                 GParamSpec *pspec,
+                                                 gpointer    data)
+{
+    gtk_widget_queue_resize (GTK_WIDGET (button));
+}
+
+static void
+hildon_button_size_request                      (GtkWidget      *widget,
+                                                 GtkRequisition *requisition)
+{
+    /* Without a child, GtkButton only requests space for its frame */
+    GTK_WIDGET_CLASS (hildon_button_parent_class)->size_request (widget, requisition);
+
+    if (lightweight_active (HILDON_BUTTON (widget)))
+        lightweight_size_request (HILDON_BUTTON (widget), requisition);
+}
+
+static void
+hildon_button_size_allocate                     (GtkWidget     *widget,
+                                                 GtkAllocation *allocation)
+{
+    GTK_WIDGET_CLASS (hildon_button_parent_class)->size_allocate (widget, allocation);
+
+    if (lightweight_active (HILDON_BUTTON (widget)))
+        lightweight_size_allocate (HILDON_BUTTON (widget));
+}
+
+static gboolean
+hildon_button_expose_event                      (GtkWidget      *widget,
+                                                 GdkEventExpose *event)
+{
+    HildonButton *button = HILDON_BUTTON (widget);
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (widget);
+
+    GTK_WIDGET_CLASS (hildon_button_parent_class)->expose_event (widget, event);
+
+    if (GTK_WIDGET_DRAWABLE (widget) && lightweight_active (button)) {
+        GtkStateType state = GTK_WIDGET_STATE (widget);
+
+        lightweight_ensure (button);
+
+        if (priv->title_text && priv->title_text[0])
+            lightweight_draw_label (button, event, priv->title_layout, &priv->title_area,
+                                    priv->title_xalign, priv->title_yalign,
+                                    &priv->title_colors[state]);
+        if (priv->value_text && priv->value_text[0])
+            lightweight_draw_label (button, event, priv->value_layout, &priv->value_area,
+                                    priv->value_xalign, priv->value_yalign,
+                                    &priv->value_colors[state]);
+        if (priv->image_pixbuf)
+            lightweight_draw_image (button, event);
     }
+
+    return FALSE;
+}
+
+static void
+hildon_button_direction_changed                 (GtkWidget        *widget,
+                                                 GtkTextDirection  previous_direction)
+{
+    HILDON_BUTTON_GET_PRIVATE (widget)->lightweight_valid = FALSE;
+
+    GTK_WIDGET_CLASS (hildon_button_parent_class)->direction_changed (widget, previous_direction);
 }
 
 static void
@@ -254,6 +860,16 @@ hildon_button_style_set                         (GtkWidget *widget,
     if (priv->setting_style)
         return;
 
+    /* Lightweight buttons resolve their style when it's next needed */
+    if (priv->lightweight) {
+        priv->lightweight_valid = FALSE;
+        return;
+    }
+
+    /* Not constructed yet */
+    if (priv->label_box == NULL)
+        return;
+
     gtk_widget_style_get (widget,
                           "horizontal-spacing", &horizontal_spacing,
                           "vertical-spacing", &vertical_spacing,
@@ -274,13 +890,167 @@ hildon_button_style_set                         (GtkWidget *widget,
     set_logical_color (widget);
 }
 
+/* Creates the labels and containers used outside of lightweight mode */
+static void
+hildon_button_create_children                   (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    priv->title = GTK_LABEL (gtk_label_new (NULL));
+    priv->value = GTK_LABEL (gtk_label_new (NULL));
+    priv->alignment = gtk_alignment_new (0.5, 0.5, 0, 0);
+
+    gtk_widget_set_name (GTK_WIDGET (priv->title), "hildon-button-title");
+    gtk_widget_set_name (GTK_WIDGET (priv->value), "hildon-button-value");
+
+    gtk_misc_set_alignment (GTK_MISC (priv->title), 0, 0.5);
+    gtk_misc_set_alignment (GTK_MISC (priv->value), 0, 0.5);
+
+    g_object_ref_sink (priv->alignment);
+
+    /* The labels are not shown automatically, see hildon_button_set_(title|value) */
+    gtk_widget_set_no_show_all (GTK_WIDGET (priv->title), TRUE);
+    gtk_widget_set_no_show_all (GTK_WIDGET (priv->value), TRUE);
+
+    /* Pack everything */
+    if (priv->arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL) {
+        priv->label_box = gtk_vbox_new (FALSE, 0);
+    } else {
+        priv->label_box = gtk_hbox_new (FALSE, 0);
+    }
+
+    g_object_ref_sink (priv->label_box);
+
+    /* If we pack both labels with (TRUE, TRUE) or (FALSE, FALSE) they
+     * can be painted outside of the button in some situations, see
+     * NB#88126 and NB#110689 */
+    gtk_box_pack_start (GTK_BOX (priv->label_box), GTK_WIDGET (priv->title), FALSE, FALSE, 0);
+    gtk_box_pack_start (GTK_BOX (priv->label_box), GTK_WIDGET (priv->value), TRUE, TRUE, 0);
+
+    set_logical_font (GTK_WIDGET (button));
+    set_logical_color (GTK_WIDGET (button));
+}
+
+/* Moves the texts and alignments kept by hildon_button_stores_contents()
+ * to the labels and the alignment, which must exist by now */
+static void
+hildon_button_apply_stored_contents             (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    gfloat xalign, yalign;
+
+    gtk_label_set_text (priv->title, priv->title_text);
+    gtk_label_set_text (priv->value, priv->value_text);
+    if (priv->title_text && priv->title_text[0])
+        gtk_widget_show (GTK_WIDGET (priv->title));
+    if (priv->value_text && priv->value_text[0])
+        gtk_widget_show (GTK_WIDGET (priv->value));
+    gtk_misc_set_alignment (GTK_MISC (priv->title), priv->title_xalign, priv->title_yalign);
+    gtk_misc_set_alignment (GTK_MISC (priv->value), priv->value_xalign, priv->value_yalign);
+
+    gtk_button_get_alignment (GTK_BUTTON (button), &xalign, &yalign);
+    gtk_alignment_set (GTK_ALIGNMENT (priv->alignment), xalign, yalign,
+                       priv->xscale, priv->yscale);
+
+    g_free (priv->title_text);
+    g_free (priv->value_text);
+    priv->title_text = priv->value_text = NULL;
+}
+
+/* Turns a lightweight button into a regular one, keeping its contents.
+ * Used for the features that need the child widgets */
+static void
+hildon_button_leave_lightweight_mode            (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    if (!priv->lightweight)
+        return;
+
+    priv->lightweight = FALSE;
+    g_signal_handlers_disconnect_by_func (button, lightweight_alignment_notify, NULL);
+
+    hildon_button_create_children (button);
+    hildon_button_apply_stored_contents (button);
+
+    /* The image is owned by the button from now on */
+    if (priv->image)
+        g_signal_handlers_disconnect_by_func (priv->image, lightweight_image_notify, button);
+
+    hildon_button_construct_child (button);
+
+    if (priv->image)
+        g_object_unref (priv->image);
+
+    if (priv->title_layout) {
+        g_object_unref (priv->title_layout);
+        g_object_unref (priv->value_layout);
+        priv->title_layout = priv->value_layout = NULL;
+    }
+    if (priv->image_pixbuf) {
+        g_object_unref (priv->image_pixbuf);
+        priv->image_pixbuf = NULL;
+    }
+
+    gtk_widget_queue_resize (GTK_WIDGET (button));
+
+    g_object_notify (G_OBJECT (button), "lightweight");
+}
+
+static void
+hildon_button_constructed                       (GObject *object)
+{
+    HildonButton *button = HILDON_BUTTON (object);
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    GtkWidget *image;
+
+    if (G_OBJECT_CLASS (hildon_button_parent_class)->constructed)
+        G_OBJECT_CLASS (hildon_button_parent_class)->constructed (object);
+
+    /* Subclasses can set the texts, alignments and image from their
+     * instance init functions, before the construct properties tell
+     * which kind of button this is. The texts and alignments are kept
+     * as in lightweight mode, and the image is just stored. */
+    if (priv->lightweight) {
+        g_signal_connect (button, "notify::xalign",
+                          G_CALLBACK (lightweight_alignment_notify), NULL);
+        g_signal_connect (button, "notify::yalign",
+                          G_CALLBACK (lightweight_alignment_notify), NULL);
+
+        image = priv->image;
+        priv->image = NULL;
+        if (image)
+            hildon_button_set_image (button, image);
+    } else {
+        hildon_button_create_children (button);
+        hildon_button_apply_stored_contents (button);
+        hildon_button_construct_child (button);
+    }
+}
+
 static void
 hildon_button_finalize                          (GObject *object)
 {
     HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (object);
 
-    g_object_unref (priv->alignment);
-    g_object_unref (priv->label_box);
+    if (priv->alignment)
+        g_object_unref (priv->alignment);
+    if (priv->label_box)
+        g_object_unref (priv->label_box);
+
+    if (priv->lightweight && priv->image) {
+        g_signal_handlers_disconnect_by_func (priv->image, lightweight_image_notify, object);
+        g_object_unref (priv->image);
+    }
+
+    g_free (priv->title_text);
+    g_free (priv->value_text);
+    if (priv->title_layout) {
+        g_object_unref (priv->title_layout);
+        g_object_unref (priv->value_layout);
+    }
+    if (priv->image_pixbuf)
+        g_object_unref (priv->image_pixbuf);
 
     G_OBJECT_CLASS (hildon_button_parent_class)->finalize (object);
 }
@@ -293,8 +1063,14 @@ hildon_button_class_init                        (HildonButtonClass *klass)
 
     gobject_class->set_property = hildon_button_set_property;
     gobject_class->get_property = hildon_button_get_property;
+    gobject_class->constructed = hildon_button_constructed;
     gobject_class->finalize = hildon_button_finalize;
     widget_class->style_set = hildon_button_style_set;
+    widget_class->size_request = hildon_button_size_request;
+    widget_class->size_allocate = hildon_button_size_allocate;
+    widget_class->expose_event = hildon_button_expose_event;
+    widget_class->direction_changed = hildon_button_direction_changed;
+    widget_class->get_accessible = hildon_button_get_accessible;
 
     g_object_class_install_property (
         gobject_class,
@@ -349,6 +1125,32 @@ hildon_button_class_init                        (HildonButtonClass *klass)
             HILDON_BUTTON_STYLE_NORMAL,
             G_PARAM_READWRITE));
 
+    /**
+     * HildonButton:lightweight:
+     *
+     * Whether the button draws its title, value and image itself
+     * instead of using child widgets. Lightweight buttons are faster to
+     * create and to restyle, which matters when there are hundreds of
+     * them. The API of #HildonButton works the same way in both modes.
+     *
+     * Only #GtkImage<!-- -->s showing a pixbuf, a stock item or a named
+     * icon can be drawn by the button. Setting any other image, or
+     * adding the title, value or image to a #GtkSizeGroup, turns the
+     * button back into a regular one, and this property becomes
+     * %FALSE.
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (
+        gobject_class,
+        PROP_LIGHTWEIGHT,
+        g_param_spec_boolean (
+            "lightweight",
+            "Lightweight",
+            "Whether the button draws its contents without child widgets",
+            FALSE,
+            G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
     gtk_widget_class_install_style_property (
         widget_class,
         g_param_spec_uint (
@@ -375,9 +1177,9 @@ hildon_button_init                              (HildonButton *self)
 {
     HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (self);
 
-    priv->title = GTK_LABEL (gtk_label_new (NULL));
-    priv->value = GTK_LABEL (gtk_label_new (NULL));
-    priv->alignment = gtk_alignment_new (0.5, 0.5, 0, 0);
+    priv->title = NULL;
+    priv->value = NULL;
+    priv->alignment = NULL;
     priv->image = NULL;
     priv->image_position = GTK_POS_LEFT;
     priv->image_xalign = 0.5;
@@ -385,21 +1187,19 @@ hildon_button_init                              (HildonButton *self)
     priv->hbox = NULL;
     priv->label_box = NULL;
     priv->style = HILDON_BUTTON_STYLE_NORMAL;
+    priv->arrangement = HILDON_BUTTON_ARRANGEMENT_HORIZONTAL;
     priv->setting_style = FALSE;
 
-    gtk_widget_set_name (GTK_WIDGET (priv->title), "hildon-button-title");
-    gtk_widget_set_name (GTK_WIDGET (priv->value), "hildon-button-value");
-
-    hildon_button_set_style (self, HILDON_BUTTON_STYLE_NORMAL);
-
-    gtk_misc_set_alignment (GTK_MISC (priv->title), 0, 0.5);
-    gtk_misc_set_alignment (GTK_MISC (priv->value), 0, 0.5);
-
-    g_object_ref_sink (priv->alignment);
-
-    /* The labels are not shown automatically, see hildon_button_set_(title|value) */
-    gtk_widget_set_no_show_all (GTK_WIDGET (priv->title), TRUE);
-    gtk_widget_set_no_show_all (GTK_WIDGET (priv->value), TRUE);
+    priv->lightweight = FALSE;
+    priv->lightweight_valid = FALSE;
+    priv->title_text = NULL;
+    priv->value_text = NULL;
+    priv->title_layout = NULL;
+    priv->value_layout = NULL;
+    priv->image_pixbuf = NULL;
+    priv->title_xalign = priv->value_xalign = 0;
+    priv->title_yalign = priv->value_yalign = 0.5;
+    priv->xscale = priv->yscale = 0;
 
     gtk_button_set_focus_on_click (GTK_BUTTON (self), FALSE);
 }
@@ -410,6 +1210,7 @@ hildon_button_init                              (HildonButton *self)
  * @size_group: A #GtkSizeGroup for the button title (main label)
  *
  * Adds the title label of @button to @size_group.
+ * @size_group can be a #HildonSizeGroup.
  *
  * Since: 2.2
  **/
@@ -422,9 +1223,13 @@ hildon_button_add_title_size_group              (HildonButton *button,
     g_return_if_fail (HILDON_IS_BUTTON (button));
     g_return_if_fail (GTK_IS_SIZE_GROUP (size_group));
 
+    hildon_button_leave_lightweight_mode (button);
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
-    gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->title));
+    if (HILDON_IS_SIZE_GROUP (size_group))
+        hildon_size_group_add_widget (HILDON_SIZE_GROUP (size_group), GTK_WIDGET (priv->title));
+    else
+        gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->title));
 }
 
 /**
@@ -433,6 +1238,7 @@ hildon_button_add_title_size_group              (HildonButton *button,
  * @size_group: A #GtkSizeGroup for the button value (secondary label)
  *
  * Adds the value label of @button to @size_group.
+ * @size_group can be a #HildonSizeGroup.
  *
  * Since: 2.2
  **/
@@ -445,9 +1251,13 @@ hildon_button_add_value_size_group              (HildonButton *button,
     g_return_if_fail (HILDON_IS_BUTTON (button));
     g_return_if_fail (GTK_IS_SIZE_GROUP (size_group));
 
+    hildon_button_leave_lightweight_mode (button);
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
-    gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->value));
+    if (HILDON_IS_SIZE_GROUP (size_group))
+        hildon_size_group_add_widget (HILDON_SIZE_GROUP (size_group), GTK_WIDGET (priv->value));
+    else
+        gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->value));
 }
 
 /**
@@ -457,6 +1267,7 @@ hildon_button_add_value_size_group              (HildonButton *button,
  *
  * Adds the image of @button to @size_group. You must add an image
  * using hildon_button_set_image() before calling this function.
+ * @size_group can be a #HildonSizeGroup.
  *
  * Since: 2.2
  **/
@@ -473,7 +1284,11 @@ hildon_button_add_image_size_group              (HildonButton *button,
 
     g_return_if_fail (GTK_IS_WIDGET (priv->image));
 
-    gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->image));
+    hildon_button_leave_lightweight_mode (button);
+    if (HILDON_IS_SIZE_GROUP (size_group))
+        hildon_size_group_add_widget (HILDON_SIZE_GROUP (size_group), GTK_WIDGET (priv->image));
+    else
+        gtk_size_group_add_widget (size_group, GTK_WIDGET (priv->image));
 }
 
 /**
@@ -569,23 +1384,63 @@ hildon_button_set_arrangement                   (HildonButton            *button
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
-    /* Pack everything */
-    if (arrangement == HILDON_BUTTON_ARRANGEMENT_VERTICAL) {
-        priv->label_box = gtk_vbox_new (FALSE, 0);
-        set_logical_font (GTK_WIDGET (button));
-    } else {
-        priv->label_box = gtk_hbox_new (FALSE, 0);
+    /* The contents are created once all construct properties are set */
+    priv->arrangement = arrangement;
+}
+
+/* Lightweight buttons have no labels for the accessible object to take
+ * its name from, so it is set from the title, or else the value. Once
+ * set, the name is kept up to date even if the button stops being
+ * lightweight. */
+static void
+hildon_button_update_accessible_name            (HildonButton *button)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (button);
+    const gchar *name;
+
+    if (!priv->accessible_name_set)
+        return;
+
+    name = hildon_button_get_title (button);
+    if (name == NULL || name[0] == '\0')
+        name = hildon_button_get_value (button);
+
+    atk_object_set_name (gtk_widget_get_accessible (GTK_WIDGET (button)),
+                         name ? name : "");
+}
+
+static AtkObject *
+hildon_button_get_accessible                    (GtkWidget *widget)
+{
+    HildonButtonPrivate *priv = HILDON_BUTTON_GET_PRIVATE (widget);
+    AtkObject *accessible;
+
+    accessible = GTK_WIDGET_CLASS (hildon_button_parent_class)->get_accessible (widget);
+
+    /* The accessible object is only created on demand, so lightweight
+     * buttons don't pay for it unless it's used */
+    if (priv->lightweight && !priv->accessible_name_set) {
+        priv->accessible_name_set = TRUE;
+        hildon_button_update_accessible_name (HILDON_BUTTON (widget));
     }
 
-    g_object_ref_sink (priv->label_box);
+    return accessible;
+}
 
-    /* If we pack both labels with (TRUE, TRUE) or (FALSE, FALSE) they
-     * can be painted outside of the button in some situations, see
-     * NB#88126 and NB#110689 */
-    gtk_box_pack_start (GTK_BOX (priv->label_box), GTK_WIDGET (priv->title), FALSE, FALSE, 0);
-    gtk_box_pack_start (GTK_BOX (priv->label_box), GTK_WIDGET (priv->value), TRUE, TRUE, 0);
+/* Sets the text of a label of a lightweight button */
+static void
+lightweight_set_text                            (HildonButton  *button,
+                                                 gchar        **text,
+                                                 PangoLayout   *layout,
+                                                 const gchar   *new_text)
+{
+    g_free (*text);
+    *text = g_strdup (new_text);
 
-    hildon_button_construct_child (button);
+    if (layout)
+        pango_layout_set_text (layout, new_text ? new_text : "", -1);
+
+    gtk_widget_queue_resize (GTK_WIDGET (button));
 }
 
 /**
@@ -611,6 +1466,14 @@ hildon_button_set_title                         (HildonButton *button,
     g_return_if_fail (HILDON_IS_BUTTON (button));
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    if (hildon_button_stores_contents (priv)) {
+        lightweight_set_text (button, &priv->title_text, priv->title_layout, title);
+        hildon_button_update_accessible_name (button);
+        g_object_notify (G_OBJECT (button), "title");
+        return;
+    }
+
     gtk_label_set_text (priv->title, title);
 
     /* If the button has no title, hide the label so the value is
@@ -622,6 +1485,7 @@ hildon_button_set_title                         (HildonButton *button,
         gtk_widget_hide (GTK_WIDGET (priv->title));
     }
 
+    hildon_button_update_accessible_name (button);
     g_object_notify (G_OBJECT (button), "title");
 }
 
@@ -648,6 +1512,14 @@ hildon_button_set_value                         (HildonButton *button,
     g_return_if_fail (HILDON_IS_BUTTON (button));
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
+
+    if (hildon_button_stores_contents (priv)) {
+        lightweight_set_text (button, &priv->value_text, priv->value_layout, value);
+        hildon_button_update_accessible_name (button);
+        g_object_notify (G_OBJECT (button), "value");
+        return;
+    }
+
     gtk_label_set_text (priv->value, value);
 
     /* If the button has no value, hide the label so the title is
@@ -659,6 +1531,7 @@ hildon_button_set_value                         (HildonButton *button,
         gtk_widget_hide (GTK_WIDGET (priv->value));
     }
 
+    hildon_button_update_accessible_name (button);
     g_object_notify (G_OBJECT (button), "value");
 }
 
@@ -686,6 +1559,9 @@ hildon_button_get_title                         (HildonButton *button)
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
+    if (hildon_button_stores_contents (priv))
+        return priv->title_text ? priv->title_text : "";
+
     return gtk_label_get_text (priv->title);
 }
 
@@ -713,6 +1589,9 @@ hildon_button_get_value                         (HildonButton *button)
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
+    if (hildon_button_stores_contents (priv))
+        return priv->value_text ? priv->value_text : "";
+
     return gtk_label_get_text (priv->value);
 }
 
@@ -760,6 +1639,25 @@ hildon_button_set_image                         (HildonButton *button,
     if (image == priv->image)
         return;
 
+    if (priv->lightweight && image && !lightweight_can_draw_image (image))
+        hildon_button_leave_lightweight_mode (button);
+
+    if (priv->lightweight) {
+        if (image) {
+            g_object_ref_sink (image);
+            g_signal_connect (image, "notify",
+                              G_CALLBACK (lightweight_image_notify), button);
+        }
+        if (priv->image) {
+            g_signal_handlers_disconnect_by_func (priv->image, lightweight_image_notify, button);
+            g_object_unref (priv->image);
+        }
+        priv->image = image;
+        priv->lightweight_valid = FALSE;
+        gtk_widget_queue_resize (GTK_WIDGET (button));
+        return;
+    }
+
     if (priv->image && priv->image->parent)
         gtk_container_remove (GTK_CONTAINER (priv->image->parent), priv->image);
 
@@ -854,6 +1752,14 @@ hildon_button_set_alignment                     (HildonButton *button,
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
+    if (hildon_button_stores_contents (priv)) {
+        priv->xscale = xscale;
+        priv->yscale = yscale;
+        gtk_button_set_alignment (GTK_BUTTON (button), xalign, yalign);
+        gtk_widget_queue_resize (GTK_WIDGET (button));
+        return;
+    }
+
     child = gtk_bin_get_child (GTK_BIN (button));
 
     /* If the button has no child, use priv->alignment, which is the default one */
@@ -888,6 +1794,13 @@ hildon_button_set_title_alignment               (HildonButton *button,
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
+    if (hildon_button_stores_contents (priv)) {
+        priv->title_xalign = xalign;
+        priv->title_yalign = yalign;
+        gtk_widget_queue_draw (GTK_WIDGET (button));
+        return;
+    }
+
     gtk_misc_set_alignment (GTK_MISC (priv->title), xalign, yalign);
 }
 
@@ -914,6 +1827,13 @@ hildon_button_set_value_alignment               (HildonButton *button,
 
     priv = HILDON_BUTTON_GET_PRIVATE (button);
 
+    if (hildon_button_stores_contents (priv)) {
+        priv->value_xalign = xalign;
+        priv->value_yalign = yalign;
+        gtk_widget_queue_draw (GTK_WIDGET (button));
+        return;
+    }
+
     gtk_misc_set_alignment (GTK_MISC (priv->value), xalign, yalign);
 }
 
@@ -1010,6 +1930,12 @@ hildon_button_construct_child                   (HildonButton *button)
     gint image_spacing;
     const gchar *title, *value;
 
+    /* Lightweight buttons lay out their contents themselves */
+    if (priv->lightweight) {
+        gtk_widget_queue_resize (GTK_WIDGET (button));
+        return;
+    }
+
     /* Don't do anything if the button is not constructed yet */
     if (G_UNLIKELY (priv->label_box == NULL))
         return;
@@ -43,6 +43,7 @@
 #include                                        "hildon-defines.h"
 #include                                        "hildon-caption.h"
 #include                                        "hildon-caption-private.h"
+#include                                        "hildon-size-group.h"
 
 #define                                         _(String)\
                                                 dgettext("hildon-libs", String)
@@ -394,13 +395,17 @@ hildon_caption_set_property                     (GObject *object,
 
         case PROP_SIZE_GROUP:
             /* Detach from previous size group */
-            if (priv->group)
+            if (HILDON_IS_SIZE_GROUP (priv->group))
+                hildon_size_group_remove_widget (HILDON_SIZE_GROUP (priv->group), priv->caption_area);
+            else if (priv->group)
                 gtk_size_group_remove_widget (priv->group, priv->caption_area);
 
             priv->group = g_value_get_object (value);
 
             /* Attach to new size group */
-            if (priv->group)
+            if (HILDON_IS_SIZE_GROUP (priv->group))
+                hildon_size_group_add_widget (HILDON_SIZE_GROUP (priv->group), priv->caption_area);
+            else if (priv->group)
                 gtk_size_group_add_widget (priv->group, priv->caption_area);
 
             gtk_widget_queue_draw (GTK_WIDGET(object));
@@ -758,7 +763,8 @@ hildon_caption_forall                           (GtkContainer *container,
  * @caption: a #HildonCaption
  * @new_group: a #GtkSizeGroup
  *
- * Sets a #GtkSizeGroup of a given captioned control.
+ * Sets a #GtkSizeGroup of a given captioned control. A #HildonSizeGroup
+ * can be used to avoid measuring every caption again when one changes.
  *
  */
 void 
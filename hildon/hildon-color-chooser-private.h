@@ -53,10 +53,19 @@ struct                                          _HildonColorChooserPrivate
 
     struct {
         unsigned short last_expose_hue;
+        unsigned short last_expose_sat;
+        unsigned short last_expose_val;
 
-        GTimeVal last_expose_time;
+        GTimeVal last_frame_time;
+
+        guint frame_source;
+        gboolean frame_pending;
 
         int expose_queued;
+
+        guint frames_rendered;
+        guint frames_coalesced;
+        guint frames_dropped;
     } expose_info;
 };
 
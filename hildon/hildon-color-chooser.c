@@ -113,13 +113,18 @@ static inline void
 inline_clip_to_alloc                            (void *s,
                                                  GtkAllocation *a);
 
-static inline void
-inline_sub_times                                (GTimeVal *result,
-                                                 GTimeVal *greater,
+static inline glong
+inline_elapsed_msec                             (GTimeVal *greater,
                                                  GTimeVal *lesser);
 
-static inline void
-inline_limited_expose                           (HildonColorChooser *self);
+static void
+hildon_color_chooser_render_frame               (HildonColorChooser *self);
+
+static void
+hildon_color_chooser_schedule_frame             (HildonColorChooser *self);
+
+static void
+hildon_color_chooser_stop_frames                (HildonColorChooser *self);
 
 static inline void
 inline_draw_hue_bar                             (GtkWidget *widget,
@@ -165,7 +170,7 @@ inline_h2rgb                                    (unsigned short hue,
                                                  unsigned long *rgb);
 
 static gboolean
-hildon_color_chooser_expose_timer               (gpointer data);
+hildon_color_chooser_frame_tick                 (gpointer data);
 
 static void
 hildon_color_chooser_set_property               (GObject *object,
@@ -179,7 +184,8 @@ hildon_color_chooser_get_property               (GObject *object,
                                                  GValue *value,
                                                  GParamSpec *pspec);
 
-#define                                         EXPOSE_INTERVAL 50000
+/* Redraws caused by dragging are paced to one per this many milliseconds */
+#define                                         FRAME_INTERVAL 40
 
 #define                                         FULL_COLOR8 0xff
 
@@ -242,10 +248,17 @@ hildon_color_chooser_init                       (HildonColorChooser *sel)
     priv->mousestate = 0;
     priv->mousein = FALSE;
 
-    g_get_current_time (&priv->expose_info.last_expose_time);
+    g_get_current_time (&priv->expose_info.last_frame_time);
 
     priv->expose_info.last_expose_hue = priv->currhue;
+    priv->expose_info.last_expose_sat = priv->currsat;
+    priv->expose_info.last_expose_val = priv->currval;
+    priv->expose_info.frame_source = 0;
+    priv->expose_info.frame_pending = FALSE;
     priv->expose_info.expose_queued = 0;
+    priv->expose_info.frames_rendered = 0;
+    priv->expose_info.frames_coalesced = 0;
+    priv->expose_info.frames_dropped = 0;
 
     priv->dimmed_plane = NULL;
     priv->dimmed_bar = NULL;
@@ -326,6 +339,8 @@ hildon_color_chooser_dispose                    (HildonColorChooser *sel)
     HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
     g_assert (priv);
 
+    hildon_color_chooser_stop_frames (sel);
+
     if (priv->dimmed_bar != NULL) {
         g_object_unref (priv->dimmed_bar);
         priv->dimmed_bar = NULL;
@@ -426,6 +441,8 @@ hildon_color_chooser_unrealize                  (GtkWidget *widget)
 
     g_assert (priv);
 
+    hildon_color_chooser_stop_frames (HILDON_COLOR_CHOOSER (widget));
+
     if (priv->event_window) {
 	gdk_window_set_user_data (priv->event_window, NULL);
 	gdk_window_destroy (priv->event_window);
@@ -539,8 +556,6 @@ hildon_color_chooser_expose                     (GtkWidget *widget,
 
         priv->expose_info.expose_queued = 0;
 
-        g_get_current_time (&priv->expose_info.last_expose_time);
-
     } else {
         /* clip hue bar region */
         area.x = event->area.x;
@@ -574,25 +589,41 @@ hildon_color_chooser_expose                     (GtkWidget *widget,
 }
 
 
-static inline void
-inline_sub_times                                (GTimeVal *result,
-                                                 GTimeVal *greater,
+static inline glong
+inline_elapsed_msec                             (GTimeVal *greater,
                                                  GTimeVal *lesser)
 {
-    result->tv_sec = greater->tv_sec - lesser->tv_sec;
-    result->tv_usec = greater->tv_usec - lesser->tv_usec;
-
-    if (result->tv_usec < 0) {
-        result->tv_sec--;
-        result->tv_usec += 1000000;
-    }
+    return (greater->tv_sec - lesser->tv_sec) * 1000 +
+        (greater->tv_usec - lesser->tv_usec) / 1000;
 }
 
-static inline void
-inline_limited_expose                           (HildonColorChooser *sel)
+static void
+hildon_color_chooser_render_frame               (HildonColorChooser *sel)
 {
-    GTimeVal curr_time, result;
     GdkEventExpose event;
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
+
+    g_assert (priv);
+
+    priv->expose_info.frame_pending = FALSE;
+    priv->expose_info.expose_queued = 1;
+    priv->expose_info.frames_rendered++;
+
+    event.type = GDK_EXPOSE;
+    event.area.width = 0;
+    event.area.height = 0;
+    event.window = GTK_WIDGET (sel)->window;
+
+    gtk_widget_send_expose (GTK_WIDGET (sel), (GdkEvent *) &event);
+}
+
+/* Pointer updates are merged into frames: the first update after an
+ * idle period is drawn right away and starts the frame clock, all the
+ * updates arriving before the next tick are drawn once, with the latest
+ * position, when that tick fires. The clock stops after an idle tick. */
+static void
+hildon_color_chooser_schedule_frame             (HildonColorChooser *sel)
+{
     HildonColorChooserPrivate *priv;
 
     if (! GTK_WIDGET_REALIZED (GTK_WIDGET (sel))) {
@@ -602,31 +633,42 @@ inline_limited_expose                           (HildonColorChooser *sel)
     priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
     g_assert (priv);
 
-    if(priv->currhue == priv->expose_info.last_expose_hue) {
+    if (priv->currhue == priv->expose_info.last_expose_hue &&
+        priv->currsat == priv->expose_info.last_expose_sat &&
+        priv->currval == priv->expose_info.last_expose_val) {
         return; /* no need to redraw */
     }
 
     priv->expose_info.last_expose_hue = priv->currhue;
+    priv->expose_info.last_expose_sat = priv->currsat;
+    priv->expose_info.last_expose_val = priv->currval;
+
+    if (priv->expose_info.frame_source == 0) {
+        g_get_current_time (&priv->expose_info.last_frame_time);
+        priv->expose_info.frame_source =
+            gdk_threads_add_timeout_full (GDK_PRIORITY_REDRAW, FRAME_INTERVAL,
+                                          hildon_color_chooser_frame_tick, sel, NULL);
+        hildon_color_chooser_render_frame (sel);
+    } else if (priv->expose_info.frame_pending) {
+        priv->expose_info.frames_coalesced++;
+    } else {
+        priv->expose_info.frame_pending = TRUE;
+    }
+}
 
-    g_get_current_time (&curr_time);
-
-    inline_sub_times (&result, &curr_time, &priv->expose_info.last_expose_time);
-
-    if(result.tv_sec != 0 || result.tv_usec >= EXPOSE_INTERVAL) {
-
-        priv->expose_info.expose_queued = 1;
-
-        event.type = GDK_EXPOSE;
-        event.area.width = 0;
-        event.area.height = 0;
-        event.window = GTK_WIDGET(sel)->window;
+static void
+hildon_color_chooser_stop_frames                (HildonColorChooser *sel)
+{
+    HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
 
-        gtk_widget_send_expose(GTK_WIDGET(sel), (GdkEvent *)&event);
+    g_assert (priv);
 
-    } else if(! priv->expose_info.expose_queued) {
-        priv->expose_info.expose_queued = 1;
-        gdk_threads_add_timeout ((EXPOSE_INTERVAL - result.tv_usec) / 1000, hildon_color_chooser_expose_timer, sel);
+    if (priv->expose_info.frame_source) {
+        g_source_remove (priv->expose_info.frame_source);
+        priv->expose_info.frame_source = 0;
     }
+
+    priv->expose_info.frame_pending = FALSE;
 }
 
 static gboolean
@@ -651,7 +693,7 @@ hildon_color_chooser_button_press               (GtkWidget *widget,
         priv->currval = tmp * 0xffff / priv->spa.width;
 
         g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-        gtk_widget_queue_draw (widget);
+        hildon_color_chooser_schedule_frame (sel);
 
         priv->mousestate = 1;
         priv->mousein = TRUE;
@@ -665,7 +707,7 @@ hildon_color_chooser_button_press               (GtkWidget *widget,
         priv->currhue = tmp * 0xffff / priv->hba.height;
 
         g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-        inline_limited_expose (sel);
+        hildon_color_chooser_schedule_frame (sel);
 
         priv->mousestate = 2;
         priv->mousein = TRUE;
@@ -716,7 +758,7 @@ hildon_color_chooser_pointer_motion             (GtkWidget *widget,
             priv->currval = (((long)(x - priv->spa.x)) * 0xffff) / priv->spa.width;
 
             g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-            gtk_widget_queue_draw(widget);
+            hildon_color_chooser_schedule_frame (sel);
 
         } else if (priv->mousein == TRUE) {
         }
@@ -732,7 +774,7 @@ hildon_color_chooser_pointer_motion             (GtkWidget *widget,
                 priv->currhue = tmp;
 
                 g_signal_emit (sel, color_chooser_signals[COLOR_CHANGED], 0);
-                inline_limited_expose (sel);
+                hildon_color_chooser_schedule_frame (sel);
             }
 
         } else if (priv->mousein == TRUE) {
@@ -845,7 +887,7 @@ hildon_color_chooser_set_color                  (HildonColorChooser *chooser,
     priv->currsat = sat;
     priv->currval = val;
 
-    inline_limited_expose (chooser);
+    hildon_color_chooser_schedule_frame (chooser);
     g_signal_emit (chooser, color_chooser_signals[COLOR_CHANGED], 0);
 }
 
@@ -1260,18 +1302,34 @@ inline_draw_sv_plane_dimmed                     (HildonColorChooser *sel,
 
 
 static gboolean
-hildon_color_chooser_expose_timer               (gpointer data)
+hildon_color_chooser_frame_tick                 (gpointer data)
 {
     HildonColorChooser *sel = HILDON_COLOR_CHOOSER (data);
     HildonColorChooserPrivate *priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (sel);
+    GTimeVal now;
+    glong elapsed;
 
     g_assert (priv);
 
-    if (priv->expose_info.expose_queued) {
-        gtk_widget_queue_draw (GTK_WIDGET (data));
+    g_get_current_time (&now);
+    elapsed = inline_elapsed_msec (&now, &priv->expose_info.last_frame_time);
+    priv->expose_info.last_frame_time = now;
+
+    /* A tick arriving late under load accounts for the frames it skipped */
+    if (elapsed >= 2 * FRAME_INTERVAL) {
+        priv->expose_info.frames_dropped += elapsed / FRAME_INTERVAL - 1;
     }
 
-    return FALSE;
+    if (! priv->expose_info.frame_pending ||
+        ! GTK_WIDGET_REALIZED (GTK_WIDGET (sel))) {
+        priv->expose_info.frame_source = 0;
+        priv->expose_info.frame_pending = FALSE;
+        return FALSE;
+    }
+
+    hildon_color_chooser_render_frame (sel);
+
+    return TRUE;
 }
 
 /**
@@ -1311,6 +1369,44 @@ hildon_color_chooser_get_color                  (HildonColorChooser *chooser,
         ((color->blue >> (16 - system_visual->blue_prec)) << system_visual->blue_shift);
 }
 
+/**
+ * hildon_color_chooser_get_frame_stats:
+ * @chooser: a #HildonColorChooser
+ * @rendered: return location for the number of frames drawn, or %NULL
+ * @coalesced: return location for the number of updates merged into an
+ * already pending frame, or %NULL
+ * @dropped: return location for the number of frames skipped because
+ * the frame timer fired late, or %NULL
+ *
+ * Retrieves statistics about the redraws done while the selected color
+ * changes, e.g. while the user drags the hue or saturation/value cursors.
+ * The counters accumulate over the lifetime of @chooser.
+ *
+ * Since: 2.2.25
+ */
+void
+hildon_color_chooser_get_frame_stats            (HildonColorChooser *chooser,
+                                                 guint *rendered,
+                                                 guint *coalesced,
+                                                 guint *dropped)
+{
+    HildonColorChooserPrivate *priv;
+
+    g_return_if_fail (HILDON_IS_COLOR_CHOOSER (chooser));
+
+    priv = HILDON_COLOR_CHOOSER_GET_PRIVATE (chooser);
+    g_assert (priv);
+
+    if (rendered)
+        *rendered = priv->expose_info.frames_rendered;
+
+    if (coalesced)
+        *coalesced = priv->expose_info.frames_coalesced;
+
+    if (dropped)
+        *dropped = priv->expose_info.frames_dropped;
+}
+
 /**
  * hildon_color_chooser_new:
  *
@@ -80,6 +80,12 @@ void
 hildon_color_chooser_get_color                  (HildonColorChooser *chooser, 
                                                  GdkColor *color);
 
+void
+hildon_color_chooser_get_frame_stats            (HildonColorChooser *chooser,
+                                                 guint *rendered,
+                                                 guint *coalesced,
+                                                 guint *dropped);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_COLOR_CHOOSER_H__ */
@@ -37,6 +37,24 @@ struct                                          _HildonControlbarPrivate
 {
     gboolean button_press;
     gint old_value;
+
+    /* Block rectangles, computed once per allocation, style and range */
+    GdkRectangle *blocks;
+    gint n_blocks;
+    gint separating_pixels;
+    gboolean dimmed;
+    gboolean layout_valid;
+
+    /* Number of blocks drawn as active */
+    gint active_blocks;
+
+    /* Areas of the steppers, computed with the blocks */
+    GdkRectangle steppers[2];
+
+    /* Whether the value was at the lower or upper bound when the
+       steppers were last drawn, which sets their sensitivity */
+    gboolean at_lower;
+    gboolean at_upper;
 };
 
 G_END_DECLS
@@ -129,6 +129,18 @@ hildon_controlbar_expose_event                  (GtkWidget *widget,
 static void
 hildon_controlbar_size_request                  (GtkWidget *self, 
                                                  GtkRequisition *req);
+
+static void
+hildon_controlbar_size_allocate                 (GtkWidget *widget,
+                                                 GtkAllocation *allocation);
+
+static void
+hildon_controlbar_style_set                     (GtkWidget *widget,
+                                                 GtkStyle *previous_style);
+
+static void
+hildon_controlbar_finalize                      (GObject *object);
+
 static void
 hildon_controlbar_paint                         (HildonControlbar *self, 
                                                  GdkRectangle * area);
@@ -153,6 +165,13 @@ static void
 hildon_controlbar_value_changed                 (GtkAdjustment *adj, 
                                                  GtkRange *range);
 
+static void
+hildon_controlbar_update_blocks                 (GtkAdjustment *adj,
+                                                 GtkRange *range);
+
+static void
+hildon_controlbar_invalidate_layout             (HildonControlbar *self);
+
 static gboolean
 hildon_controlbar_change_value                  (GtkRange *range, 
                                                  GtkScrollType scroll,
@@ -204,7 +223,10 @@ hildon_controlbar_class_init                    (HildonControlbarClass *controlb
     gobject_class->get_property         = hildon_controlbar_get_property;
     gobject_class->set_property         = hildon_controlbar_set_property;
     gobject_class->constructor          = hildon_controlbar_constructor;
+    gobject_class->finalize             = hildon_controlbar_finalize;
     widget_class->size_request          = hildon_controlbar_size_request;
+    widget_class->size_allocate         = hildon_controlbar_size_allocate;
+    widget_class->style_set             = hildon_controlbar_style_set;
     widget_class->button_press_event    = hildon_controlbar_button_press_event;
     widget_class->button_release_event  = hildon_controlbar_button_release_event;
     widget_class->expose_event          = hildon_controlbar_expose_event;
@@ -281,6 +303,12 @@ hildon_controlbar_init                          (HildonControlbar *controlbar)
 
     priv->button_press = FALSE;
     priv->old_value = 0;
+    priv->blocks = NULL;
+    priv->n_blocks = 0;
+    priv->layout_valid = FALSE;
+    priv->active_blocks = 1;
+    priv->at_lower = TRUE;
+    priv->at_upper = FALSE;
     range = GTK_RANGE (controlbar);
 
     range->round_digits = -1;
@@ -312,11 +340,36 @@ hildon_controlbar_constructor                   (GType type,
     adj->page_increment = HILDON_CONTROLBAR_PAGE_INCREMENT;
     adj->page_size = HILDON_CONTROLBAR_PAGE_SIZE;
 
+    /* GtkRange redraws the whole widget whenever the value changes, as
+     * its slider moves. The slider is not drawn for controlbars, so
+     * its handler is replaced by one that only redraws the blocks that
+     * switch between active and inactive */
+    g_signal_handlers_block_matched (adj, G_SIGNAL_MATCH_ID | G_SIGNAL_MATCH_DATA,
+            g_signal_lookup ("value-changed", GTK_TYPE_ADJUSTMENT), 0,
+            NULL, NULL, obj);
+
     g_signal_connect (adj, "value-changed", 
             G_CALLBACK (hildon_controlbar_value_changed), obj);
+    g_signal_connect (adj, "value-changed",
+            G_CALLBACK (hildon_controlbar_update_blocks), obj);
+    g_signal_connect_swapped (adj, "changed",
+            G_CALLBACK (hildon_controlbar_invalidate_layout), obj);
     return obj;
 }
 
+static void
+hildon_controlbar_finalize                      (GObject *object)
+{
+    HildonControlbarPrivate *priv = HILDON_CONTROLBAR_GET_PRIVATE (object);
+    g_assert (priv);
+
+    g_free (priv->blocks);
+    priv->blocks = NULL;
+
+    if (G_OBJECT_CLASS (parent_class)->finalize)
+        G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void 
 hildon_controlbar_set_property                  (GObject *object, 
                                                  guint param_id,
@@ -720,6 +773,25 @@ hildon_controlbar_button_release_event          (GtkWidget *widget,
     return result;
 }
 
+static void
+hildon_controlbar_size_allocate                 (GtkWidget *widget,
+                                                 GtkAllocation *allocation)
+{
+    GTK_WIDGET_CLASS (parent_class)->size_allocate (widget, allocation);
+
+    hildon_controlbar_invalidate_layout (HILDON_CONTROLBAR (widget));
+}
+
+static void
+hildon_controlbar_style_set                     (GtkWidget *widget,
+                                                 GtkStyle *previous_style)
+{
+    if (GTK_WIDGET_CLASS (parent_class)->style_set)
+        GTK_WIDGET_CLASS (parent_class)->style_set (widget, previous_style);
+
+    hildon_controlbar_invalidate_layout (HILDON_CONTROLBAR (widget));
+}
+
 /*
  * Event handler for expose event
  */
@@ -766,12 +838,33 @@ hildon_controlbar_expose_event                  (GtkWidget *widget,
 }
 
 /*
- * Paint method.
- * This is where all the work is actually done...
+ * Number of blocks drawn as active for the current value.
  */
+static gint
+hildon_controlbar_get_active_blocks             (HildonControlbar *self)
+{
+    GtkAdjustment *ctrlbar = GTK_RANGE (self)->adjustment;
+    gint block_count = ctrlbar->value - ctrlbar->lower + 1;
+
+    return MAX (block_count, 1);
+}
+
 static void
-hildon_controlbar_paint                         (HildonControlbar *self,
-                                                 GdkRectangle *area)
+hildon_controlbar_invalidate_layout             (HildonControlbar *self)
+{
+    HildonControlbarPrivate *priv = HILDON_CONTROLBAR_GET_PRIVATE (self);
+    g_assert (priv);
+
+    priv->layout_valid = FALSE;
+}
+
+/*
+ * Computes the rectangle of every block. The layout only depends on
+ * the allocation, the style and the range of the controlbar, so it is
+ * kept until one of them changes.
+ */
+static void
+hildon_controlbar_update_layout                 (HildonControlbar *self)
 {
     HildonControlbarPrivate *priv;
     GtkWidget *widget = GTK_WIDGET(self);
@@ -785,30 +878,50 @@ hildon_controlbar_paint                         (HildonControlbar *self,
     gint stepper_spacing = 0;
     gint inner_border_width = 0;
     gint block_area = 0, block_width = 0, block_x = 0, block_max = 0, block_height,block_y;
-    /* Number of blocks on the controlbar */
-    guint block_count = 0;
-    /* Number of displayed active blocks */
-    guint block_act = 0;
     /* Minimum no. of blocks visible */
     guint block_min = 0;
     gint separatingpixels = 2;
     gint block_remains = 0;
     gint i, start_x, end_x, current_width;
-    GtkStateType state = GTK_STATE_NORMAL;
-
-    g_return_if_fail(area);
 
     priv = HILDON_CONTROLBAR_GET_PRIVATE(self);
     g_assert (priv);
 
-    if (GTK_WIDGET_SENSITIVE (self) == FALSE)
-        state = GTK_STATE_INSENSITIVE;
+    if (priv->layout_valid)
+        return;
+
+    priv->layout_valid = TRUE;
+    priv->dimmed = FALSE;
+    priv->n_blocks = 0;
+    g_free (priv->blocks);
+    priv->blocks = NULL;
+
+    /* The blocks are centered vertically when the controlbar is higher
+     * than its default height, see hildon_controlbar_expose_event() */
+    if (h > DEFAULT_HEIGHT) {
+        int difference = h - DEFAULT_HEIGHT;
+
+        if (difference & 1)
+            difference += 1;
+
+        y += difference / 2;
+        h = DEFAULT_HEIGHT;
+    }
 
     gtk_widget_style_get (GTK_WIDGET (self),
             "stepper-size", &stepper_size,
             "stepper-spacing", &stepper_spacing,
             "inner_border_width", &inner_border_width, NULL);
 
+    /* Each stepper takes everything between the blocks and its end of
+     * the controlbar */
+    priv->steppers[0].x = x;
+    priv->steppers[0].y = widget->allocation.y;
+    priv->steppers[0].width = MIN (stepper_size + stepper_spacing + inner_border_width, w);
+    priv->steppers[0].height = widget->allocation.height;
+    priv->steppers[1] = priv->steppers[0];
+    priv->steppers[1].x = x + w - priv->steppers[0].width;
+
     block_area = (w - 2 * stepper_size - 2 * stepper_spacing - 2 * inner_border_width);
 
     if (block_area <= 0)
@@ -816,7 +929,6 @@ hildon_controlbar_paint                         (HildonControlbar *self,
 
     block_min = 1;
     block_max = ctrlbar->upper - ctrlbar->lower + block_min; 
-    block_act = priv->old_value - GTK_RANGE (self)->adjustment->lower + block_min;
 
     /* We check border width and maximum value and adjust
      * separating pixels for block width here. If the block size would
@@ -837,7 +949,7 @@ hildon_controlbar_paint                         (HildonControlbar *self,
     if (block_max == 0)
     {
         /* If block max is 0 then we dim the whole control. */
-        state = GTK_STATE_INSENSITIVE;
+        priv->dimmed = TRUE;
         block_width = block_area;
         block_remains = 0;
         block_max = 1;
@@ -854,16 +966,16 @@ hildon_controlbar_paint                         (HildonControlbar *self,
     block_y = y + inner_border_width;
     block_height = h - 2 * inner_border_width;
 
-    block_count = ctrlbar->value - ctrlbar->lower +  block_min;
-
-    if (block_count == 0)
-            block_count = 1;
     /* Without this there is vertical block corruption when block_height = 
        1. This should work from 0 up to whatever */
 
     if (block_height < 2)
         block_height = 2;
 
+    priv->separating_pixels = separatingpixels;
+    priv->n_blocks = block_max;
+    priv->blocks = g_new (GdkRectangle, block_max);
+
     /* 
      * Changed the drawing of the blocks completely,
      * because of "do-not-resize-when-changing-max"-specs.
@@ -879,15 +991,112 @@ hildon_controlbar_paint                         (HildonControlbar *self,
         end_x = block_width * i + (i * block_remains) / block_max;
         current_width = end_x - start_x;
 
-        gtk_paint_box (widget->style, widget->window, state,
-                (i <= block_count) ? GTK_SHADOW_IN : GTK_SHADOW_OUT,
-                NULL, widget, "hildon_block",
-                block_x, block_y, current_width,
-                block_height);
+        priv->blocks[i - 1].x = block_x;
+        priv->blocks[i - 1].y = block_y;
+        priv->blocks[i - 1].width = current_width;
+        priv->blocks[i - 1].height = block_height;
 
         /* We keep the block_x separate because of the
            'separatingpixels' */
         block_x += current_width + separatingpixels;
     }
+}
+
+/*
+ * Replaces the "value-changed" handler of GtkRange: only the blocks
+ * between the old and the new value are redrawn, and the steppers when
+ * the value reaches or leaves a bound, as their sensitivity changes.
+ */
+static void
+hildon_controlbar_update_blocks                 (GtkAdjustment *adj,
+                                                 GtkRange *range)
+{
+    HildonControlbar *self = HILDON_CONTROLBAR (range);
+    HildonControlbarPrivate *priv = HILDON_CONTROLBAR_GET_PRIVATE (self);
+    gint active_blocks, first, last, i;
+    gboolean at_lower, at_upper;
+    GdkRectangle area;
+
+    g_assert (priv);
+
+    active_blocks = hildon_controlbar_get_active_blocks (self);
+    at_lower = adj->value <= adj->lower;
+    at_upper = adj->value >= adj->upper - adj->page_size;
+
+    /* GtkRange recomputes the slider position on its next expose */
+    range->need_recalc = TRUE;
+
+    if (active_blocks != priv->active_blocks && GTK_WIDGET_DRAWABLE (range)) {
+        hildon_controlbar_update_layout (self);
+
+        first = MIN (active_blocks, priv->active_blocks);
+        last = MIN (MAX (active_blocks, priv->active_blocks), priv->n_blocks);
+
+        if (first < last) {
+            area = priv->blocks[first];
+            for (i = first + 1; i < last; i++)
+                gdk_rectangle_union (&area, &priv->blocks[i], &area);
+
+            gtk_widget_queue_draw_area (GTK_WIDGET (range),
+                    area.x, area.y, area.width, area.height);
+        }
+    }
+
+    if ((at_lower != priv->at_lower || at_upper != priv->at_upper) &&
+            GTK_WIDGET_DRAWABLE (range)) {
+        hildon_controlbar_update_layout (self);
+
+        for (i = 0; i < (gint) G_N_ELEMENTS (priv->steppers); i++)
+            gtk_widget_queue_draw_area (GTK_WIDGET (range),
+                    priv->steppers[i].x, priv->steppers[i].y,
+                    priv->steppers[i].width, priv->steppers[i].height);
+    }
+
+    priv->active_blocks = active_blocks;
+    priv->at_lower = at_lower;
+    priv->at_upper = at_upper;
 
+    g_signal_emit_by_name (range, "value-changed");
+}
+
+/*
+ * Paint method.
+ * Only the blocks that intersect @area are drawn.
+ */
+static void
+hildon_controlbar_paint                         (HildonControlbar *self,
+                                                 GdkRectangle *area)
+{
+    HildonControlbarPrivate *priv;
+    GtkWidget *widget = GTK_WIDGET(self);
+    GdkRectangle intersection;
+    /* Number of blocks on the controlbar */
+    gint block_count = 0;
+    gint i;
+    GtkStateType state = GTK_STATE_NORMAL;
+
+    g_return_if_fail(area);
+
+    priv = HILDON_CONTROLBAR_GET_PRIVATE(self);
+    g_assert (priv);
+
+    hildon_controlbar_update_layout (self);
+
+    if (GTK_WIDGET_SENSITIVE (self) == FALSE || priv->dimmed)
+        state = GTK_STATE_INSENSITIVE;
+
+    block_count = hildon_controlbar_get_active_blocks (self);
+    priv->active_blocks = block_count;
+
+    for (i = 0; i < priv->n_blocks; i++) {
+
+        if (!gdk_rectangle_intersect (area, &priv->blocks[i], &intersection))
+            continue;
+
+        gtk_paint_box (widget->style, widget->window, state,
+                (i < block_count) ? GTK_SHADOW_IN : GTK_SHADOW_OUT,
+                NULL, widget, "hildon_block",
+                priv->blocks[i].x, priv->blocks[i].y,
+                priv->blocks[i].width, priv->blocks[i].height);
+    }
 }
@@ -0,0 +1,91 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+#ifndef                                         __HILDON_FIND_TOOLBAR_HISTORY_PRIVATE_H__
+#define                                         __HILDON_FIND_TOOLBAR_HISTORY_PRIVATE_H__
+
+#include                                        <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define                                         HILDON_TYPE_FIND_TOOLBAR_HISTORY \
+                                                (hildon_find_toolbar_history_get_type())
+
+#define                                         HILDON_FIND_TOOLBAR_HISTORY(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_CAST ((obj), \
+                                                HILDON_TYPE_FIND_TOOLBAR_HISTORY, \
+                                                HildonFindToolbarHistory))
+
+#define                                         HILDON_IS_FIND_TOOLBAR_HISTORY(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_TYPE ((obj), \
+                                                HILDON_TYPE_FIND_TOOLBAR_HISTORY))
+
+typedef struct                                  _HildonFindToolbarHistory HildonFindToolbarHistory;
+
+typedef struct                                  _HildonFindToolbarHistoryClass HildonFindToolbarHistoryClass;
+
+/* Search history of a HildonFindToolbar that has no "list" set: a
+ * GtkTreeModel with one string column over a ring of up to "capacity"
+ * entries. Row 0 is the oldest entry, the last row the most recent one. */
+struct                                          _HildonFindToolbarHistory
+{
+    GObject     parent;
+
+    /* Ring of "n_slots" slots, "length" of them used from "first" on.
+       It grows as entries are added, up to "capacity" slots */
+    gchar     **items;
+    guint       n_slots;
+    guint       capacity;
+    guint       first;
+    guint       length;
+
+    /* Entry string -> slot in items */
+    GHashTable *slots;
+
+    gint        stamp;
+};
+
+struct                                          _HildonFindToolbarHistoryClass
+{
+    GObjectClass parent_class;
+};
+
+G_GNUC_INTERNAL GType
+hildon_find_toolbar_history_get_type            (void) G_GNUC_CONST;
+
+G_GNUC_INTERNAL HildonFindToolbarHistory *
+hildon_find_toolbar_history_new                 (guint capacity);
+
+G_GNUC_INTERNAL void
+hildon_find_toolbar_history_append              (HildonFindToolbarHistory *history,
+                                                 const gchar *string);
+
+G_GNUC_INTERNAL void
+hildon_find_toolbar_history_set_capacity        (HildonFindToolbarHistory *history,
+                                                 guint capacity);
+
+G_END_DECLS
+
+#endif                                          /* __HILDON_FIND_TOOLBAR_HISTORY_PRIVATE_H__ */
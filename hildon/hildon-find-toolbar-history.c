@@ -0,0 +1,407 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+
+/*
+ * Search history used by HildonFindToolbar when the application has not
+ * set a "list". Entries are kept in a ring of up to history-limit slots,
+ * allocated as entries are added, so
+ * adding an entry evicts the oldest one in constant time, and a hash
+ * table from string to slot finds duplicates without scanning the
+ * history. Moving a duplicate to the end of the history shifts the
+ * entries that were newer than it, which is bounded by the capacity.
+ */
+
+#include                                        <string.h>
+
+#include                                        "hildon-find-toolbar-history-private.h"
+
+static void
+hildon_find_toolbar_history_tree_model_init     (GtkTreeModelIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (HildonFindToolbarHistory, hildon_find_toolbar_history, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GTK_TYPE_TREE_MODEL,
+                                                hildon_find_toolbar_history_tree_model_init));
+
+#define                                         ROW_SLOT(history, row) \
+                                                (((history)->first + (row)) % (history)->n_slots)
+
+#define                                         ITER_ROW(iter) \
+                                                GPOINTER_TO_UINT ((iter)->user_data)
+
+static void
+hildon_find_toolbar_history_set_iter            (HildonFindToolbarHistory *history,
+                                                 GtkTreeIter *iter,
+                                                 guint row)
+{
+    iter->stamp = history->stamp;
+    iter->user_data = GUINT_TO_POINTER (row);
+    iter->user_data2 = NULL;
+    iter->user_data3 = NULL;
+}
+
+static void
+hildon_find_toolbar_history_finalize            (GObject *object)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (object);
+    guint row;
+
+    for (row = 0; row < history->length; row++)
+        g_free (history->items[ROW_SLOT (history, row)]);
+
+    g_free (history->items);
+    g_hash_table_destroy (history->slots);
+
+    G_OBJECT_CLASS (hildon_find_toolbar_history_parent_class)->finalize (object);
+}
+
+static void
+hildon_find_toolbar_history_class_init          (HildonFindToolbarHistoryClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->finalize = hildon_find_toolbar_history_finalize;
+}
+
+static void
+hildon_find_toolbar_history_init                (HildonFindToolbarHistory *history)
+{
+    /* The strings are owned by items */
+    history->slots = g_hash_table_new (g_str_hash, g_str_equal);
+    history->stamp = g_random_int ();
+}
+
+static GtkTreeModelFlags
+hildon_find_toolbar_history_get_flags           (GtkTreeModel *model)
+{
+    return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint
+hildon_find_toolbar_history_get_n_columns       (GtkTreeModel *model)
+{
+    return 1;
+}
+
+static GType
+hildon_find_toolbar_history_get_column_type     (GtkTreeModel *model,
+                                                 gint index)
+{
+    g_return_val_if_fail (index == 0, G_TYPE_INVALID);
+
+    return G_TYPE_STRING;
+}
+
+static gboolean
+hildon_find_toolbar_history_get_iter            (GtkTreeModel *model,
+                                                 GtkTreeIter *iter,
+                                                 GtkTreePath *path)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (model);
+    gint row;
+
+    if (gtk_tree_path_get_depth (path) != 1)
+        return FALSE;
+
+    row = gtk_tree_path_get_indices (path)[0];
+    if (row < 0 || (guint) row >= history->length)
+        return FALSE;
+
+    hildon_find_toolbar_history_set_iter (history, iter, row);
+
+    return TRUE;
+}
+
+static GtkTreePath *
+hildon_find_toolbar_history_get_path            (GtkTreeModel *model,
+                                                 GtkTreeIter *iter)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (model);
+    GtkTreePath *path;
+
+    g_return_val_if_fail (iter->stamp == history->stamp, NULL);
+
+    path = gtk_tree_path_new ();
+    gtk_tree_path_append_index (path, ITER_ROW (iter));
+
+    return path;
+}
+
+static void
+hildon_find_toolbar_history_get_value           (GtkTreeModel *model,
+                                                 GtkTreeIter *iter,
+                                                 gint column,
+                                                 GValue *value)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (model);
+
+    g_return_if_fail (column == 0);
+    g_return_if_fail (iter->stamp == history->stamp);
+    g_return_if_fail (ITER_ROW (iter) < history->length);
+
+    g_value_init (value, G_TYPE_STRING);
+    g_value_set_string (value, history->items[ROW_SLOT (history, ITER_ROW (iter))]);
+}
+
+static gboolean
+hildon_find_toolbar_history_iter_next           (GtkTreeModel *model,
+                                                 GtkTreeIter *iter)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (model);
+    guint row = ITER_ROW (iter) + 1;
+
+    g_return_val_if_fail (iter->stamp == history->stamp, FALSE);
+
+    if (row >= history->length) {
+        iter->stamp = 0;
+        return FALSE;
+    }
+
+    iter->user_data = GUINT_TO_POINTER (row);
+
+    return TRUE;
+}
+
+static gboolean
+hildon_find_toolbar_history_iter_nth_child      (GtkTreeModel *model,
+                                                 GtkTreeIter *iter,
+                                                 GtkTreeIter *parent,
+                                                 gint n)
+{
+    HildonFindToolbarHistory *history = HILDON_FIND_TOOLBAR_HISTORY (model);
+
+    if (parent != NULL || n < 0 || (guint) n >= history->length)
+        return FALSE;
+
+    hildon_find_toolbar_history_set_iter (history, iter, n);
+
+    return TRUE;
+}
+
+static gboolean
+hildon_find_toolbar_history_iter_children       (GtkTreeModel *model,
+                                                 GtkTreeIter *iter,
+                                                 GtkTreeIter *parent)
+{
+    return hildon_find_toolbar_history_iter_nth_child (model, iter, parent, 0);
+}
+
+static gboolean
+hildon_find_toolbar_history_iter_has_child      (GtkTreeModel *model,
+                                                 GtkTreeIter *iter)
+{
+    return FALSE;
+}
+
+static gint
+hildon_find_toolbar_history_iter_n_children     (GtkTreeModel *model,
+                                                 GtkTreeIter *iter)
+{
+    return iter == NULL ? HILDON_FIND_TOOLBAR_HISTORY (model)->length : 0;
+}
+
+static gboolean
+hildon_find_toolbar_history_iter_parent         (GtkTreeModel *model,
+                                                 GtkTreeIter *iter,
+                                                 GtkTreeIter *child)
+{
+    return FALSE;
+}
+
+static void
+hildon_find_toolbar_history_tree_model_init     (GtkTreeModelIface *iface)
+{
+    iface->get_flags = hildon_find_toolbar_history_get_flags;
+    iface->get_n_columns = hildon_find_toolbar_history_get_n_columns;
+    iface->get_column_type = hildon_find_toolbar_history_get_column_type;
+    iface->get_iter = hildon_find_toolbar_history_get_iter;
+    iface->get_path = hildon_find_toolbar_history_get_path;
+    iface->get_value = hildon_find_toolbar_history_get_value;
+    iface->iter_next = hildon_find_toolbar_history_iter_next;
+    iface->iter_children = hildon_find_toolbar_history_iter_children;
+    iface->iter_has_child = hildon_find_toolbar_history_iter_has_child;
+    iface->iter_n_children = hildon_find_toolbar_history_iter_n_children;
+    iface->iter_nth_child = hildon_find_toolbar_history_iter_nth_child;
+    iface->iter_parent = hildon_find_toolbar_history_iter_parent;
+}
+
+static void
+hildon_find_toolbar_history_row_deleted         (HildonFindToolbarHistory *history,
+                                                 guint row)
+{
+    GtkTreePath *path = gtk_tree_path_new ();
+
+    /* Rows after the deleted one have moved */
+    history->stamp++;
+
+    gtk_tree_path_append_index (path, row);
+    gtk_tree_model_row_deleted (GTK_TREE_MODEL (history), path);
+    gtk_tree_path_free (path);
+}
+
+/* Removes the oldest entry, returning its string */
+static gchar *
+hildon_find_toolbar_history_pop_first           (HildonFindToolbarHistory *history)
+{
+    gchar *string = history->items[history->first];
+
+    g_hash_table_remove (history->slots, string);
+    history->items[history->first] = NULL;
+    history->first = (history->first + 1) % history->n_slots;
+    history->length--;
+
+    hildon_find_toolbar_history_row_deleted (history, 0);
+
+    return string;
+}
+
+/* Moves the entries to a new array of @n_slots slots, which must be at
+ * least the length of the history. Rows keep their index. */
+static void
+hildon_find_toolbar_history_resize              (HildonFindToolbarHistory *history,
+                                                 guint n_slots)
+{
+    gchar **items;
+    guint row;
+
+    items = n_slots > 0 ? g_new0 (gchar *, n_slots) : NULL;
+    for (row = 0; row < history->length; row++) {
+        items[row] = history->items[ROW_SLOT (history, row)];
+        g_hash_table_insert (history->slots, items[row], GUINT_TO_POINTER (row));
+    }
+
+    g_free (history->items);
+    history->items = items;
+    history->n_slots = n_slots;
+    history->first = 0;
+}
+
+/* Removes the entry at @row, shifting the newer entries down by one,
+ * and returns its string */
+static gchar *
+hildon_find_toolbar_history_take_row            (HildonFindToolbarHistory *history,
+                                                 guint row)
+{
+    gchar *string = history->items[ROW_SLOT (history, row)];
+    guint slot;
+
+    g_hash_table_remove (history->slots, string);
+
+    for (; row + 1 < history->length; row++) {
+        slot = ROW_SLOT (history, row);
+        history->items[slot] = history->items[ROW_SLOT (history, row + 1)];
+        g_hash_table_insert (history->slots, history->items[slot], GUINT_TO_POINTER (slot));
+    }
+
+    history->items[ROW_SLOT (history, row)] = NULL;
+    history->length--;
+
+    return string;
+}
+
+HildonFindToolbarHistory *
+hildon_find_toolbar_history_new                 (guint capacity)
+{
+    HildonFindToolbarHistory *history = g_object_new (HILDON_TYPE_FIND_TOOLBAR_HISTORY, NULL);
+
+    hildon_find_toolbar_history_set_capacity (history, capacity);
+
+    return history;
+}
+
+/*
+ * Makes @string the most recent entry of @history. If @string is
+ * already in the history it is moved to the end, otherwise the oldest
+ * entry is dropped when the history is full.
+ */
+void
+hildon_find_toolbar_history_append              (HildonFindToolbarHistory *history,
+                                                 const gchar *string)
+{
+    GtkTreePath *path;
+    GtkTreeIter iter;
+    gpointer key, slot;
+    gchar *entry;
+    guint row;
+
+    g_return_if_fail (HILDON_IS_FIND_TOOLBAR_HISTORY (history));
+    g_return_if_fail (string != NULL);
+
+    if (history->capacity == 0)
+        return;
+
+    if (g_hash_table_lookup_extended (history->slots, string, &key, &slot)) {
+        row = (GPOINTER_TO_UINT (slot) + history->n_slots - history->first) % history->n_slots;
+
+        /* Already the most recent entry */
+        if (row + 1 == history->length)
+            return;
+
+        entry = hildon_find_toolbar_history_take_row (history, row);
+        hildon_find_toolbar_history_row_deleted (history, row);
+    } else {
+        if (history->length == history->capacity)
+            g_free (hildon_find_toolbar_history_pop_first (history));
+        else if (history->length == history->n_slots)
+            hildon_find_toolbar_history_resize (history,
+                    MIN (history->capacity, MAX (2 * history->n_slots, 8)));
+
+        entry = g_strdup (string);
+    }
+
+    row = history->length++;
+    history->items[ROW_SLOT (history, row)] = entry;
+    g_hash_table_insert (history->slots, entry, GUINT_TO_POINTER (ROW_SLOT (history, row)));
+    history->stamp++;
+
+    path = gtk_tree_path_new ();
+    gtk_tree_path_append_index (path, row);
+    hildon_find_toolbar_history_set_iter (history, &iter, row);
+    gtk_tree_model_row_inserted (GTK_TREE_MODEL (history), path, &iter);
+    gtk_tree_path_free (path);
+}
+
+/*
+ * Resizes the ring of @history. The oldest entries that do not fit in
+ * the new capacity are dropped.
+ */
+void
+hildon_find_toolbar_history_set_capacity        (HildonFindToolbarHistory *history,
+                                                 guint capacity)
+{
+    g_return_if_fail (HILDON_IS_FIND_TOOLBAR_HISTORY (history));
+
+    if (capacity == history->capacity)
+        return;
+
+    while (history->length > capacity)
+        g_free (hildon_find_toolbar_history_pop_first (history));
+
+    history->capacity = capacity;
+
+    /* Slots are only allocated when entries are added, so a large
+       capacity costs nothing until it is used */
+    if (history->n_slots > capacity)
+        hildon_find_toolbar_history_resize (history, capacity);
+}
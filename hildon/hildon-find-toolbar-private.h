@@ -37,6 +37,18 @@ struct                                          _HildonFindToolbarPrivate
   GtkToolItem*		close_button;
 
   gint			history_limit;
+
+  /* List store returned by "list" while the toolbar keeps its own
+     history, and whether it is being updated from that history */
+  GtkListStore*		history_store;
+  gboolean		syncing_history_store;
+
+  /* Find-as-you-type */
+  gboolean		incremental;
+  guint			incremental_delay;
+  guint			incremental_id;
+  gchar*		incremental_prefix;
+  GCancellable*		incremental_cancellable;
 };
 
 #define                                         HILDON_FIND_TOOLBAR_GET_PRIVATE(obj) \
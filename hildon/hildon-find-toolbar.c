@@ -32,6 +32,18 @@
  * #GtkListStore and can be accesed using a property 'list'. Entries are added
  * automatically to the list when the search button is pressed.
  *
+ * If no list has been set, the toolbar keeps only the last
+ * #HildonFindToolbar:history-limit entries by itself. Reading the 'list'
+ * property then returns a #GtkListStore that follows that history. As
+ * soon as the application changes the list store, the toolbar keeps the
+ * history in it instead, as if it had been set as the 'list' property.
+ *
+ * When #HildonFindToolbar:incremental is %TRUE, the toolbar also searches
+ * as the user types: once the prefix has not changed for
+ * #HildonFindToolbar:incremental-delay milliseconds it emits
+ * #HildonFindToolbar::incremental-search with a #GCancellable that is
+ * cancelled as soon as the prefix changes again.
+ *
  */
 
 #ifdef                                          HAVE_CONFIG_H
@@ -41,11 +53,13 @@
 #include                                        <string.h>
 #include                                        <libintl.h>
 #include                                        <gdk/gdkkeysyms.h>
+#include                                        <gio/gio.h>
 
 #include                                        "hildon-gtk.h"
 #include                                        "hildon-find-toolbar.h"
 #include                                        "hildon-defines.h"
 #include                                        "hildon-find-toolbar-private.h"
+#include                                        "hildon-find-toolbar-history-private.h"
 #include                                        "hildon-marshalers.h"
 
 #define                                         _(String) \
@@ -59,9 +73,20 @@
 
 #define                                         FIND_LABEL_YPADDING 0
 
+#define                                         DEFAULT_INCREMENTAL_DELAY 300
+
 static GtkTreeModel*
 hildon_find_toolbar_get_list_model              (HildonFindToolbarPrivate *priv);
 
+static HildonFindToolbarHistory*
+hildon_find_toolbar_get_history                 (HildonFindToolbarPrivate *priv);
+
+static GtkListStore*
+hildon_find_toolbar_get_history_store           (HildonFindToolbar *self);
+
+static void
+hildon_find_toolbar_release_history_store       (HildonFindToolbar *self);
+
 static GtkEntry*
 hildon_find_toolbar_get_entry                   (HildonFindToolbarPrivate *priv);
 
@@ -111,6 +136,19 @@ static void
 hildon_find_toolbar_entry_activate              (GtkWidget *widget,
                                                  gpointer user_data);
 
+static void
+hildon_find_toolbar_entry_changed               (GtkEditable *editable,
+                                                 HildonFindToolbar *self);
+
+static gboolean
+hildon_find_toolbar_incremental_timeout         (gpointer data);
+
+static void
+hildon_find_toolbar_stop_incremental            (HildonFindToolbarPrivate *priv);
+
+static void
+hildon_find_toolbar_destroy                     (GtkObject *object);
+
 static void
 hildon_find_toolbar_class_init                  (HildonFindToolbarClass *klass);
 
@@ -123,6 +161,7 @@ enum
     CLOSE,
     INVALID_INPUT,
     HISTORY_APPEND,
+    INCREMENTAL_SEARCH,
 
     LAST_SIGNAL
 };
@@ -135,11 +174,15 @@ enum
     PROP_LIST,
     PROP_COLUMN,
     PROP_MAX,
-    PROP_HISTORY_LIMIT
+    PROP_HISTORY_LIMIT,
+    PROP_INCREMENTAL,
+    PROP_INCREMENTAL_DELAY
 };
 
 static guint                                    HildonFindToolbar_signal [LAST_SIGNAL] = {0};
 
+static GtkToolbarClass*                         parent_class = NULL;
+
 /**
  * hildon_find_toolbar_get_type:
  *
@@ -178,8 +221,18 @@ hildon_find_toolbar_get_list_model              (HildonFindToolbarPrivate *priv)
     GtkTreeModel *filter_model =
         gtk_combo_box_get_model (GTK_COMBO_BOX (priv->entry_combo_box));
 
-    return filter_model == NULL ? NULL :
-        gtk_tree_model_filter_get_model (GTK_TREE_MODEL_FILTER (filter_model));
+    return GTK_IS_TREE_MODEL_FILTER (filter_model) ?
+        gtk_tree_model_filter_get_model (GTK_TREE_MODEL_FILTER (filter_model)) : NULL;
+}
+
+static HildonFindToolbarHistory*
+hildon_find_toolbar_get_history                 (HildonFindToolbarPrivate *priv)
+{
+    GtkTreeModel *model =
+        gtk_combo_box_get_model (GTK_COMBO_BOX (priv->entry_combo_box));
+
+    return HILDON_IS_FIND_TOOLBAR_HISTORY (model) ?
+        HILDON_FIND_TOOLBAR_HISTORY (model) : NULL;
 }
 
 static GtkEntry*
@@ -238,6 +291,123 @@ hildon_find_toolbar_apply_filter                (HildonFindToolbar *self,
     g_object_unref (filter);
 }
 
+/* Mirrors a new entry of the toolbar's own history in the list store */
+static void
+hildon_find_toolbar_history_store_insert        (GtkTreeModel *history,
+                                                 GtkTreePath *path,
+                                                 GtkTreeIter *iter,
+                                                 HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    gchar *string;
+
+    gtk_tree_model_get (history, iter, 0, &string, -1);
+
+    priv->syncing_history_store = TRUE;
+    gtk_list_store_insert_with_values (priv->history_store, NULL,
+            gtk_tree_path_get_indices (path)[0], 0, string, -1);
+    priv->syncing_history_store = FALSE;
+
+    g_free (string);
+}
+
+/* Mirrors the removal of an entry of the toolbar's own history */
+static void
+hildon_find_toolbar_history_store_delete        (GtkTreeModel *history,
+                                                 GtkTreePath *path,
+                                                 HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    GtkTreeIter iter;
+
+    if (!gtk_tree_model_get_iter (GTK_TREE_MODEL (priv->history_store), &iter, path))
+        return;
+
+    priv->syncing_history_store = TRUE;
+    gtk_list_store_remove (priv->history_store, &iter);
+    priv->syncing_history_store = FALSE;
+}
+
+/* The application changed the list store: it becomes the history, as
+   if it had been set as the "list" property */
+static void
+hildon_find_toolbar_history_store_changed       (HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    GtkTreeModel *store;
+
+    if (priv->syncing_history_store)
+        return;
+
+    store = g_object_ref (priv->history_store);
+    hildon_find_toolbar_release_history_store (self);
+    hildon_find_toolbar_apply_filter (self, store);
+    g_object_unref (store);
+}
+
+/* Returns a list store with the entries of the toolbar's own history,
+   oldest first, which follows the history until the application
+   changes it. The history stays the model of the combo box, so reading
+   "list" does not change how the toolbar works. */
+static GtkListStore*
+hildon_find_toolbar_get_history_store           (HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    HildonFindToolbarHistory *history;
+    guint row;
+
+    if (priv->history_store != NULL)
+        return priv->history_store;
+
+    history = hildon_find_toolbar_get_history (priv);
+    priv->history_store = gtk_list_store_new (1, G_TYPE_STRING);
+
+    for (row = 0; row < history->length; row++)
+        gtk_list_store_insert_with_values (priv->history_store, NULL, row,
+                0, history->items[(history->first + row) % history->n_slots], -1);
+
+    g_signal_connect (history, "row-inserted",
+            G_CALLBACK (hildon_find_toolbar_history_store_insert), self);
+    g_signal_connect (history, "row-deleted",
+            G_CALLBACK (hildon_find_toolbar_history_store_delete), self);
+
+    g_signal_connect_swapped (priv->history_store, "row-inserted",
+            G_CALLBACK (hildon_find_toolbar_history_store_changed), self);
+    g_signal_connect_swapped (priv->history_store, "row-changed",
+            G_CALLBACK (hildon_find_toolbar_history_store_changed), self);
+    g_signal_connect_swapped (priv->history_store, "row-deleted",
+            G_CALLBACK (hildon_find_toolbar_history_store_changed), self);
+    g_signal_connect_swapped (priv->history_store, "rows-reordered",
+            G_CALLBACK (hildon_find_toolbar_history_store_changed), self);
+
+    return priv->history_store;
+}
+
+/* Stops following the toolbar's own history with the list store */
+static void
+hildon_find_toolbar_release_history_store       (HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    HildonFindToolbarHistory *history;
+
+    if (priv->history_store == NULL)
+        return;
+
+    history = hildon_find_toolbar_get_history (priv);
+    if (history != NULL)
+    {
+        g_signal_handlers_disconnect_by_func (history,
+                hildon_find_toolbar_history_store_insert, self);
+        g_signal_handlers_disconnect_by_func (history,
+                hildon_find_toolbar_history_store_delete, self);
+    }
+
+    g_signal_handlers_disconnect_by_func (priv->history_store,
+            hildon_find_toolbar_history_store_changed, self);
+    g_object_unref (priv->history_store);
+    priv->history_store = NULL;
+}
+
 static void
 hildon_find_toolbar_get_property                (GObject *object,
                                                  guint prop_id,
@@ -263,7 +433,11 @@ hildon_find_toolbar_get_property                (GObject *object,
             break;
 
         case PROP_LIST:
-            g_value_set_object (value, hildon_find_toolbar_get_list_model(priv));
+            if (hildon_find_toolbar_get_history (priv) != NULL)
+                g_value_set_object (value,
+                        hildon_find_toolbar_get_history_store (HILDON_FIND_TOOLBAR (object)));
+            else
+                g_value_set_object (value, hildon_find_toolbar_get_list_model(priv));
             break;
 
         case PROP_COLUMN:
@@ -280,6 +454,14 @@ hildon_find_toolbar_get_property                (GObject *object,
             g_value_set_int (value, priv->history_limit);
             break;
 
+        case PROP_INCREMENTAL:
+            g_value_set_boolean (value, priv->incremental);
+            break;
+
+        case PROP_INCREMENTAL_DELAY:
+            g_value_set_uint (value, priv->incremental_delay);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
             break;
@@ -313,6 +495,7 @@ hildon_find_toolbar_set_property                (GObject *object,
 
         case PROP_LIST:
             model = GTK_TREE_MODEL (g_value_get_object(value));
+            hildon_find_toolbar_release_history_store (self);
             hildon_find_toolbar_apply_filter (self, model);
             break;
 
@@ -329,6 +512,14 @@ hildon_find_toolbar_set_property                (GObject *object,
         case PROP_HISTORY_LIMIT:
             priv->history_limit = g_value_get_int (value);
 
+            /* Our own history only keeps as many entries as it shows */
+            if (hildon_find_toolbar_get_history (priv) != NULL)
+            {
+                hildon_find_toolbar_history_set_capacity (
+                        hildon_find_toolbar_get_history (priv), priv->history_limit);
+                break;
+            }
+
             /* Re-apply the history limit to the model. */
             model = hildon_find_toolbar_get_list_model (priv);
             if (model != NULL)
@@ -347,6 +538,21 @@ hildon_find_toolbar_set_property                (GObject *object,
             }
             break;
 
+        case PROP_INCREMENTAL:
+            priv->incremental = g_value_get_boolean (value);
+
+            if (! priv->incremental)
+            {
+                hildon_find_toolbar_stop_incremental (priv);
+                g_free (priv->incremental_prefix);
+                priv->incremental_prefix = NULL;
+            }
+            break;
+
+        case PROP_INCREMENTAL_DELAY:
+            priv->incremental_delay = g_value_get_uint (value);
+            break;
+
         default:
             G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
             break;
@@ -392,8 +598,8 @@ hildon_find_toolbar_history_append              (HildonFindToolbar *self,
     gint column = 0;
     GtkTreeModel *model = NULL;
     GtkListStore *list = NULL;
+    HildonFindToolbarHistory *history;
     GtkTreeIter iter;
-    gboolean self_create = FALSE;
 
     g_object_get (self, "prefix", &string, NULL);
 
@@ -424,36 +630,34 @@ hildon_find_toolbar_history_append              (HildonFindToolbar *self,
            already exists, remove it so there are no duplicates in list. */
         if (hildon_find_toolbar_find_string (self, &iter, column, string))
             gtk_list_store_remove (list, &iter);
-    }
-    else
-    {
-        /* No list store set. Create our own. */
-        list = gtk_list_store_new (1, G_TYPE_STRING);
-        model = GTK_TREE_MODEL (list);
-        self_create = TRUE;
-    }
 
-    /* Add the string to first in list */
-    gtk_list_store_append (list, &iter);
-    gtk_list_store_set (list, &iter, column, string, -1);
+        /* Add the string to first in list */
+        gtk_list_store_append (list, &iter);
+        gtk_list_store_set (list, &iter, column, string, -1);
 
-    if(self_create)
-    {
-        /* Add the created list to ComboBoxEntry */
-        hildon_find_toolbar_apply_filter (self, model);
-        /* ComboBoxEntry keeps the only needed reference to this list */
-        g_object_unref (list);
-
-        /* Set the column only after ComboBoxEntry's model is set
-           in hildon_find_toolbar_apply_filter() */
-        g_object_set (self, "column", 0, NULL);
-    }
-    else
-    {
         /* Refilter to get the oldest entry hidden from history */
         gtk_tree_model_filter_refilter (GTK_TREE_MODEL_FILTER(
                     gtk_combo_box_get_model (GTK_COMBO_BOX(priv->entry_combo_box))));
     }
+    else
+    {
+        history = hildon_find_toolbar_get_history (priv);
+        if (history == NULL)
+        {
+            /* No list store set. Create our own history, which drops
+               the oldest entry itself so it needs no filter. */
+            history = hildon_find_toolbar_history_new (priv->history_limit);
+            gtk_combo_box_set_model (GTK_COMBO_BOX (priv->entry_combo_box),
+                    GTK_TREE_MODEL (history));
+            /* ComboBoxEntry keeps the only needed reference to it */
+            g_object_unref (history);
+
+            /* Set the column only after ComboBoxEntry's model is set */
+            g_object_set (self, "column", 0, NULL);
+        }
+
+        hildon_find_toolbar_history_append (history, string);
+    }
 
     g_free (string);
 
@@ -475,6 +679,8 @@ hildon_find_toolbar_emit_close                  (GtkButton *button,
     }
 #endif
 
+    hildon_find_toolbar_stop_incremental (HILDON_FIND_TOOLBAR_GET_PRIVATE (self));
+
     /* Clicked close button */
     g_signal_emit (self, HildonFindToolbar_signal [CLOSE], 0);
 }
@@ -496,14 +702,108 @@ hildon_find_toolbar_entry_activate              (GtkWidget *widget,
 {
     GtkWidget *find_toolbar = GTK_WIDGET (user_data);
     gboolean rb;  
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (find_toolbar);
+    g_assert (priv);
 
     /* NB#40936 stop focus from moving to next widget */
     g_signal_stop_emission_by_name (widget, "activate");
 
+    /* The full search supersedes a pending incremental one */
+    if (priv->incremental_id != 0)
+    {
+        g_source_remove (priv->incremental_id);
+        priv->incremental_id = 0;
+    }
+
     g_signal_emit (find_toolbar, HildonFindToolbar_signal [SEARCH], 0);
     g_signal_emit (find_toolbar, HildonFindToolbar_signal [HISTORY_APPEND], 0, &rb);
 }
 
+/* Cancels the running incremental search and removes the pending one */
+static void
+hildon_find_toolbar_stop_incremental            (HildonFindToolbarPrivate *priv)
+{
+    if (priv->incremental_id != 0)
+    {
+        g_source_remove (priv->incremental_id);
+        priv->incremental_id = 0;
+    }
+
+    if (priv->incremental_cancellable != NULL)
+    {
+        g_cancellable_cancel (priv->incremental_cancellable);
+        g_object_unref (priv->incremental_cancellable);
+        priv->incremental_cancellable = NULL;
+    }
+}
+
+static void
+hildon_find_toolbar_entry_changed               (GtkEditable *editable,
+                                                 HildonFindToolbar *self)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    g_assert (priv);
+
+    if (! priv->incremental)
+        return;
+
+    /* Results for the old prefix are not wanted anymore. The search
+       for the new one waits until the user stops typing. */
+    hildon_find_toolbar_stop_incremental (priv);
+
+    priv->incremental_id = gdk_threads_add_timeout (priv->incremental_delay,
+            hildon_find_toolbar_incremental_timeout, self);
+}
+
+static gboolean
+hildon_find_toolbar_incremental_timeout         (gpointer data)
+{
+    HildonFindToolbar *self = HILDON_FIND_TOOLBAR (data);
+    gchar *prefix;
+    gboolean refine;
+    GCancellable *cancellable;
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (self);
+    g_assert (priv);
+
+    priv->incremental_id = 0;
+
+    prefix = g_strdup (gtk_entry_get_text (hildon_find_toolbar_get_entry (priv)));
+
+    /* Results for a prefix of the new one can be narrowed down */
+    refine = priv->incremental_prefix != NULL && *priv->incremental_prefix != '\0' &&
+        g_str_has_prefix (prefix, priv->incremental_prefix);
+
+    g_free (priv->incremental_prefix);
+    priv->incremental_prefix = prefix;
+
+    priv->incremental_cancellable = g_cancellable_new ();
+
+    /* A handler may change the prefix, which replaces the cancellable */
+    cancellable = g_object_ref (priv->incremental_cancellable);
+    g_signal_emit (self, HildonFindToolbar_signal [INCREMENTAL_SEARCH], 0,
+            prefix, refine, cancellable);
+    g_object_unref (cancellable);
+
+    return FALSE;
+}
+
+/* Destroy can be called multiple times, remember to set pointers to NULL */
+static void
+hildon_find_toolbar_destroy                     (GtkObject *object)
+{
+    HildonFindToolbarPrivate *priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (object);
+    g_assert (priv);
+
+    hildon_find_toolbar_stop_incremental (priv);
+    hildon_find_toolbar_release_history_store (HILDON_FIND_TOOLBAR (object));
+
+    g_free (priv->incremental_prefix);
+    priv->incremental_prefix = NULL;
+
+    if (GTK_OBJECT_CLASS (parent_class)->destroy)
+        GTK_OBJECT_CLASS (parent_class)->destroy (object);
+}
+
 static void
 hildon_find_toolbar_class_init                  (HildonFindToolbarClass *klass)
 {
@@ -511,10 +811,12 @@ hildon_find_toolbar_class_init                  (HildonFindToolbarClass *klass)
 
     g_type_class_add_private (klass, sizeof (HildonFindToolbarPrivate));
 
+    parent_class = g_type_class_peek_parent (klass);
     object_class = G_OBJECT_CLASS(klass);
 
     object_class->get_property = hildon_find_toolbar_get_property;
     object_class->set_property = hildon_find_toolbar_set_property;
+    GTK_OBJECT_CLASS (klass)->destroy = hildon_find_toolbar_destroy;
 
     klass->history_append = (gpointer) hildon_find_toolbar_history_append;
 
@@ -600,6 +902,38 @@ hildon_find_toolbar_class_init                  (HildonFindToolbarClass *klass)
                 5, G_PARAM_READWRITE |
                 G_PARAM_CONSTRUCT));
 
+    /**
+     * HildonFindToolbar:incremental:
+     *
+     * Whether #HildonFindToolbar::incremental-search is emitted while the
+     * user types.
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (object_class, PROP_INCREMENTAL,
+            g_param_spec_boolean ("incremental",
+                "Incremental",
+                "Whether to search while the user types",
+                FALSE,
+                G_PARAM_READWRITE));
+
+    /**
+     * HildonFindToolbar:incremental-delay:
+     *
+     * Time in milliseconds the prefix must stay unchanged before
+     * #HildonFindToolbar::incremental-search is emitted.
+     *
+     * Since: 2.2.25
+     */
+    g_object_class_install_property (object_class, PROP_INCREMENTAL_DELAY,
+            g_param_spec_uint ("incremental-delay",
+                "Incremental delay",
+                "Milliseconds to wait after a change of the "
+                "prefix before searching for it",
+                0, G_MAXUINT,
+                DEFAULT_INCREMENTAL_DELAY, G_PARAM_READWRITE |
+                G_PARAM_CONSTRUCT));
+
     /**
      * HildonFindToolbar::search:
      * @toolbar: the toolbar which received the signal
@@ -657,6 +991,35 @@ hildon_find_toolbar_class_init                  (HildonFindToolbarClass *klass)
                 g_signal_accumulator_true_handled, NULL, 
                 _hildon_marshal_BOOLEAN__VOID,
                 G_TYPE_BOOLEAN, 0);
+
+    /**
+     * HildonFindToolbar::incremental-search:
+     * @toolbar: the toolbar which received the signal
+     * @prefix: the search string, possibly empty
+     * @refine: %TRUE if @prefix starts with the prefix of the previous
+     *          incremental search
+     * @cancellable: a #GCancellable that is cancelled when @prefix is no
+     *               longer the current search string
+     *
+     * Gets emitted when #HildonFindToolbar:incremental is %TRUE and the
+     * search string has not changed for #HildonFindToolbar:incremental-delay
+     * milliseconds.
+     *
+     * Handlers that search asynchronously should keep a reference to
+     * @cancellable and stop as soon as it is cancelled. When @refine is
+     * %TRUE and the previous search was not cancelled before it finished,
+     * its results can be filtered instead of searching again from scratch.
+     *
+     * Since: 2.2.25
+     */
+    HildonFindToolbar_signal[INCREMENTAL_SEARCH] =
+        g_signal_new(
+                "incremental-search", HILDON_TYPE_FIND_TOOLBAR,
+                G_SIGNAL_RUN_LAST, 0,
+                NULL, NULL,
+                _hildon_marshal_VOID__STRING_BOOLEAN_OBJECT,
+                G_TYPE_NONE, 3,
+                G_TYPE_STRING, G_TYPE_BOOLEAN, G_TYPE_CANCELLABLE);
 }
 
 static void
@@ -704,6 +1067,9 @@ hildon_find_toolbar_init                        (HildonFindToolbar *self)
     g_signal_connect (hildon_find_toolbar_get_entry (priv),
             "activate",
             G_CALLBACK(hildon_find_toolbar_entry_activate), self);
+    g_signal_connect (hildon_find_toolbar_get_entry (priv),
+            "changed",
+            G_CALLBACK(hildon_find_toolbar_entry_changed), self);
 
     /* Separator */
     priv->separator = gtk_separator_tool_item_new();
@@ -905,24 +1271,20 @@ gint32
 hildon_find_toolbar_get_last_index              (HildonFindToolbar *toolbar)
 {
     HildonFindToolbarPrivate *priv;
-    GtkTreeModel *filter_model;
+    GtkTreeModel *model;
+    gint n_items;
     
     g_return_val_if_fail (HILDON_IS_FIND_TOOLBAR (toolbar), FALSE);
     priv = HILDON_FIND_TOOLBAR_GET_PRIVATE (toolbar);
 
-    filter_model = gtk_combo_box_get_model (GTK_COMBO_BOX (priv->entry_combo_box));
+    model = gtk_combo_box_get_model (GTK_COMBO_BOX (priv->entry_combo_box));
 
-    if (filter_model == NULL)
+    if (model == NULL)
         return 0;
 
-    gint i = 0;
-    GtkTreeIter iter;
-
-    gtk_tree_model_get_iter_first (filter_model, &iter);
-
-    while (gtk_tree_model_iter_next (filter_model, &iter))
-        i++;
+    /* The most recent entry is always the last one */
+    n_items = gtk_tree_model_iter_n_children (model, NULL);
 
-    return i;
+    return MAX (n_items - 1, 0);
 }
 
@@ -34,6 +34,19 @@ G_BEGIN_DECLS
 
 typedef struct                                  _HildonFontSelectionDialogPrivate HildonFontSelectionDialogPrivate;
 
+typedef struct                                  _HildonFontFamilyList HildonFontFamilyList;
+
+/* Filtered and sorted font families of a font map, shared by all the
+ * dialogs until the font configuration changes */
+struct                                          _HildonFontFamilyList
+{
+    gint ref_count;
+
+    PangoFontMap *font_map;
+    PangoFontFamily **families;
+    gint n_families;
+};
+
 struct                                          _HildonFontSelectionDialogPrivate 
 {  
     GtkNotebook *notebook;
@@ -54,10 +67,16 @@ struct                                          _HildonFontSelectionDialogPrivat
     GtkWidget *chk_strikethrough;
     GtkWidget *cbx_positioning;
 
-    /* Every family */
+    /* Every family, owned by family_list */
+    HildonFontFamilyList *family_list;
     PangoFontFamily **families;
     gint n_families;
 
+    /* Families already appended to cbx_font_type, and the idle
+     * source appending the rest */
+    gint n_shown_families;
+    guint populate_id;
+
     /* color_set is used to show whether the color is inconsistent
      * The handler id is used to block the signal emission
      * when we change the color setting */
@@ -136,6 +136,9 @@ hildon_font_selection_dialog_class_init         (HildonFontSelectionDialogClass
 static void   
 hildon_font_selection_dialog_init               (HildonFontSelectionDialog *fontseldiag);
 
+static void   
+hildon_font_selection_dialog_destroy            (GtkObject *object);
+
 static void   
 hildon_font_selection_dialog_finalize           (GObject *object);
 
@@ -159,8 +162,17 @@ static void
 toggle_clicked                                  (GtkButton *button, 
                                                  gpointer unused);
 
+static void
+hildon_font_selection_dialog_append_families    (HildonFontSelectionDialogPrivate *priv,
+                                                 gint n);
+
+static void
+font_family_list_unref                          (HildonFontFamilyList *list);
+
 static GtkDialogClass*                          parent_class = NULL;
 
+static HildonFontFamilyList*                    font_family_list = NULL;
+
 #define                                         _(String) dgettext("hildon-libs", String)
 
 #define                                         SUPERSCRIPT_RISE 3333
@@ -171,6 +183,9 @@ static GtkDialogClass*                          parent_class = NULL;
 
 #define                                         OFF_BIT 0x02
 
+/* Number of families appended to the font combo box per idle */
+#define                                         FAMILIES_PER_IDLE 32
+
 /**
  * hildon_font_selection_dialog_get_type:
  *
@@ -372,6 +387,7 @@ hildon_font_selection_dialog_set_property       (GObject *object,
                 if (strcmp (family, pango_font_family_get_name (priv->families[i]))
                         == 0)
                 {
+                    hildon_font_selection_dialog_append_families (priv, i + 1);
                     gtk_combo_box_set_active (GTK_COMBO_BOX (priv->cbx_font_type), i);
                     break;
                 }
@@ -521,6 +537,7 @@ hildon_font_selection_dialog_class_init         (HildonFontSelectionDialogClass
     gobject_class = G_OBJECT_CLASS (klass);
 
     gobject_class->finalize         = hildon_font_selection_dialog_finalize;
+    GTK_OBJECT_CLASS (klass)->destroy = hildon_font_selection_dialog_destroy;
     gobject_class->get_property     = hildon_font_selection_dialog_get_property;
     gobject_class->set_property     = hildon_font_selection_dialog_set_property;
 
@@ -921,6 +938,20 @@ color_modified_cb                               (HildonColorButton *button,
     priv->color_set = TRUE;
 }
 
+static void
+hildon_font_selection_dialog_destroy            (GtkObject *object)
+{
+    HildonFontSelectionDialogPrivate *priv = HILDON_FONT_SELECTION_DIALOG_GET_PRIVATE (object);
+
+    if (priv->populate_id != 0) {
+        g_source_remove (priv->populate_id);
+        priv->populate_id = 0;
+    }
+
+    if (GTK_OBJECT_CLASS (parent_class)->destroy)
+        GTK_OBJECT_CLASS (parent_class)->destroy (object);
+}
+
 static void 
 hildon_font_selection_dialog_finalize           (GObject *object)
 {
@@ -938,8 +969,9 @@ hildon_font_selection_dialog_finalize           (GObject *object)
         priv->preview_text = NULL;
     }
 
-    if (priv->families != NULL) {
-        g_free (priv->families);
+    if (priv->family_list != NULL) {
+        font_family_list_unref (priv->family_list);
+        priv->family_list = NULL;
         priv->families = NULL;
     }
 
@@ -1270,27 +1302,154 @@ filter_out_internal_fonts                       (PangoFontFamily **families,
 }
 
 static void
-hildon_font_selection_dialog_show_available_fonts (HildonFontSelectionDialog *fontsel)
+font_family_list_unref                          (HildonFontFamilyList *list)
+{
+    gint i;
 
+    if (--list->ref_count > 0)
+        return;
+
+    for (i = 0; i < list->n_families; i++)
+        g_object_unref (list->families[i]);
+
+    g_free (list->families);
+    g_object_unref (list->font_map);
+    g_slice_free (HildonFontFamilyList, list);
+}
+
+static void
+font_family_list_invalidate                     (void)
+{
+    if (font_family_list != NULL) {
+        font_family_list_unref (font_family_list);
+        font_family_list = NULL;
+    }
+}
+
+static void
+font_family_list_fontconfig_changed             (GtkSettings *settings,
+                                                 GParamSpec *pspec,
+                                                 gpointer data)
+{
+    font_family_list_invalidate ();
+}
+
+/* Returns a new reference to the font families of the font map used by
+ * @fontsel. Listing, filtering and sorting the families is expensive
+ * on systems with many fonts, so this is done once per process and
+ * again only when the font configuration or the font map changes. */
+static HildonFontFamilyList*
+font_family_list_get                            (HildonFontSelectionDialog *fontsel)
 {
+    static gboolean settings_connected = FALSE;
+    PangoContext *context;
+    PangoFontMap *font_map;
     gint i;
 
-    HildonFontSelectionDialogPrivate *priv = HILDON_FONT_SELECTION_DIALOG_GET_PRIVATE (fontsel);
-    g_assert (priv);
+    context = gtk_widget_get_pango_context (GTK_WIDGET (fontsel));
+    font_map = pango_context_get_font_map (context);
+
+    if (font_family_list != NULL && font_family_list->font_map != font_map)
+        font_family_list_invalidate ();
+
+    if (font_family_list == NULL) {
+        font_family_list = g_slice_new0 (HildonFontFamilyList);
+        font_family_list->ref_count = 1;
+        font_family_list->font_map = g_object_ref (font_map);
 
-    pango_context_list_families (gtk_widget_get_pango_context
-            (GTK_WIDGET (fontsel)), &priv->families,
-            &priv->n_families);
+        pango_context_list_families (context, &font_family_list->families,
+                                     &font_family_list->n_families);
 
-    filter_out_internal_fonts (priv->families, &priv->n_families);
+        filter_out_internal_fonts (font_family_list->families,
+                                   &font_family_list->n_families);
 
-    qsort (priv->families, priv->n_families, sizeof(PangoFontFamily *), cmp_families);
+        qsort (font_family_list->families, font_family_list->n_families,
+               sizeof (PangoFontFamily *), cmp_families);
 
-    for (i = 0; i < priv->n_families; i++) 
+        /* The font map drops its families when the font configuration
+         * changes, but dialogs still showing them keep the list alive */
+        for (i = 0; i < font_family_list->n_families; i++)
+            g_object_ref (font_family_list->families[i]);
+    }
+
+    if (!settings_connected) {
+        g_signal_connect (gtk_settings_get_default (), "notify::gtk-fontconfig-timestamp",
+                          G_CALLBACK (font_family_list_fontconfig_changed), NULL);
+        settings_connected = TRUE;
+    }
+
+    font_family_list->ref_count++;
+
+    return font_family_list;
+}
+
+/* Appends families to the font combo box until the first @n are shown */
+static void
+hildon_font_selection_dialog_append_families    (HildonFontSelectionDialogPrivate *priv,
+                                                 gint n)
+{
+    n = MIN (n, priv->n_families);
+
+    for (; priv->n_shown_families < n; priv->n_shown_families++)
     {
-        const gchar *name = pango_font_family_get_name (priv->families[i]);
+        const gchar *name = pango_font_family_get_name (priv->families[priv->n_shown_families]);
         gtk_combo_box_append_text (GTK_COMBO_BOX (priv->cbx_font_type), name);
     }
+
+    if (priv->n_shown_families == priv->n_families && priv->populate_id != 0) {
+        g_source_remove (priv->populate_id);
+        priv->populate_id = 0;
+    }
+}
+
+static gboolean
+hildon_font_selection_dialog_populate_idle      (gpointer data)
+{
+    HildonFontSelectionDialogPrivate *priv = HILDON_FONT_SELECTION_DIALOG_GET_PRIVATE (data);
+
+    if (priv->n_shown_families + FAMILIES_PER_IDLE >= priv->n_families) {
+        priv->populate_id = 0;
+        hildon_font_selection_dialog_append_families (priv, priv->n_families);
+        return FALSE;
+    }
+
+    hildon_font_selection_dialog_append_families (priv, priv->n_shown_families + FAMILIES_PER_IDLE);
+
+    return TRUE;
+}
+
+/* The user must see every family once the combo box pops up */
+static void
+hildon_font_selection_dialog_popup_shown        (GObject *combo,
+                                                 GParamSpec *pspec,
+                                                 HildonFontSelectionDialogPrivate *priv)
+{
+    hildon_font_selection_dialog_append_families (priv, priv->n_families);
+}
+
+static void
+hildon_font_selection_dialog_show_available_fonts (HildonFontSelectionDialog *fontsel)
+
+{
+    HildonFontSelectionDialogPrivate *priv = HILDON_FONT_SELECTION_DIALOG_GET_PRIVATE (fontsel);
+    g_assert (priv);
+
+    priv->family_list = font_family_list_get (fontsel);
+    priv->families = priv->family_list->families;
+    priv->n_families = priv->family_list->n_families;
+    priv->n_shown_families = 0;
+
+    /* Only the first families are appended now, so that the dialog can
+     * be mapped right away; the rest are appended in idle chunks */
+    hildon_font_selection_dialog_append_families (priv, FAMILIES_PER_IDLE);
+
+    if (priv->n_shown_families < priv->n_families)
+        priv->populate_id = gdk_threads_add_idle_full (G_PRIORITY_DEFAULT_IDLE,
+                                                       hildon_font_selection_dialog_populate_idle,
+                                                       fontsel, NULL);
+
+    g_signal_connect (priv->cbx_font_type, "notify::popup-shown",
+                      G_CALLBACK (hildon_font_selection_dialog_popup_shown), priv);
 }
 
 static void
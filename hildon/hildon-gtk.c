@@ -455,6 +455,32 @@ hildon_gtk_window_enable_zoom_keys              (GtkWindow *window,
     hildon_gtk_window_set_flag (window, (HildonFlagFunc) do_set_zoom_keys, GUINT_TO_POINTER (enable));
 }
 
+static void
+send_screenshot_message                         (GtkWindow *window,
+                                                 gboolean   take)
+{
+    XEvent xev = { 0 };
+
+    xev.xclient.type = ClientMessage;
+    xev.xclient.serial = 0;
+    xev.xclient.send_event = True;
+    xev.xclient.display = GDK_DISPLAY_XDISPLAY (gtk_widget_get_display (GTK_WIDGET (window)));
+    xev.xclient.window = XDefaultRootWindow (xev.xclient.display);
+    xev.xclient.message_type = hildon_private_get_xatom (gtk_widget_get_display (GTK_WIDGET (window)),
+                                                         HILDON_ATOM_HILDON_LOADING_SCREENSHOT);
+    xev.xclient.format = 32;
+    xev.xclient.data.l[0] = take ? 0 : 1;
+    xev.xclient.data.l[1] = GDK_WINDOW_XID (GTK_WIDGET (window)->window);
+
+    XSendEvent (xev.xclient.display,
+                xev.xclient.window,
+                False,
+                SubstructureRedirectMask | SubstructureNotifyMask,
+                &xev);
+
+    XFlush (xev.xclient.display);
+}
+
 /**
  * hildon_gtk_window_take_screenshot:
  * @window: a #GtkWindow
@@ -482,29 +508,12 @@ void
 hildon_gtk_window_take_screenshot               (GtkWindow *window,
                                                  gboolean   take)
 {
-    XEvent xev = { 0 };
-
     g_return_if_fail (GTK_IS_WINDOW (window));
     g_return_if_fail (GTK_WIDGET_MAPPED (window));
 
-    xev.xclient.type = ClientMessage;
-    xev.xclient.serial = 0;
-    xev.xclient.send_event = True;
-    xev.xclient.display = GDK_DISPLAY_XDISPLAY (gtk_widget_get_display (GTK_WIDGET (window)));
-    xev.xclient.window = XDefaultRootWindow (xev.xclient.display);
-    xev.xclient.message_type = XInternAtom (xev.xclient.display, "_HILDON_LOADING_SCREENSHOT", False);
-    xev.xclient.format = 32;
-    xev.xclient.data.l[0] = take ? 0 : 1;
-    xev.xclient.data.l[1] = GDK_WINDOW_XID (GTK_WIDGET (window)->window);
-
-    XSendEvent (xev.xclient.display,
-                xev.xclient.window,
-                False,
-                SubstructureRedirectMask | SubstructureNotifyMask,
-                &xev);
+    send_screenshot_message (window, take);
 
-    XFlush (xev.xclient.display);
-    XSync (xev.xclient.display, False);
+    XSync (GDK_DISPLAY_XDISPLAY (gtk_widget_get_display (GTK_WIDGET (window))), False);
 }
 
 /* XIfEvent() predicate to check for a reply to a
@@ -513,9 +522,8 @@ static Bool
 screenshot_done (Display *dpy, const XEvent *event, GtkWindow *window)
 {
   return event->type == ClientMessage
-    && event->xclient.message_type == XInternAtom (dpy,
-                                           "_HILDON_LOADING_SCREENSHOT",
-                                           False)
+    && event->xclient.message_type == hildon_private_get_xatom (gdk_x11_lookup_xdisplay (dpy),
+                                                                HILDON_ATOM_HILDON_LOADING_SCREENSHOT)
     && event->xclient.window == GDK_WINDOW_XID (GTK_WIDGET (window)->window);
 }
 
@@ -525,7 +533,9 @@ screenshot_done (Display *dpy, const XEvent *event, GtkWindow *window)
  * @take: %TRUE to take a screenshot, %FALSE to destroy the existing one.
  *
  * Like hildon_gtk_window_take_screenshot() but blocks until the
- * operation is complete.
+ * operation is complete. The whole process is blocked until the window
+ * manager replies, see hildon_gtk_window_take_screenshot_async() to
+ * keep the main loop running meanwhile.
  *
  * Since: 2.2.9
  *
@@ -543,6 +553,184 @@ hildon_gtk_window_take_screenshot_sync          (GtkWindow *window,
             &foo, (void *)screenshot_done, (XPointer)window);
 }
 
+#define                                         SCREENSHOT_REQUEST_KEY "hildon-screenshot-request"
+
+typedef struct
+{
+    GtkWindow                *window;
+    GdkWindow                *gdkwin;
+    HildonScreenshotCallback  callback;
+    gpointer                  user_data;
+    GDestroyNotify            destroy;
+    guint                     timeout_id;
+    GCancellable             *cancellable;
+    gulong                    cancelled_id;
+} HildonScreenshotRequest;
+
+static GdkFilterReturn
+screenshot_request_filter                       (GdkXEvent *xevent,
+                                                 GdkEvent  *event,
+                                                 gpointer   data);
+
+static void
+screenshot_request_finish                       (HildonScreenshotRequest *request,
+                                                 gboolean                 completed)
+{
+    GtkWindow *window = request->window;
+
+    g_object_steal_data (G_OBJECT (window), SCREENSHOT_REQUEST_KEY);
+
+    gdk_window_remove_filter (request->gdkwin, screenshot_request_filter, request);
+    g_object_unref (request->gdkwin);
+
+    if (request->timeout_id)
+        g_source_remove (request->timeout_id);
+
+    if (request->cancellable) {
+        g_signal_handler_disconnect (request->cancellable, request->cancelled_id);
+        g_object_unref (request->cancellable);
+    }
+
+    g_signal_handlers_disconnect_matched (window, G_SIGNAL_MATCH_DATA,
+                                          0, 0, NULL, NULL, request);
+
+    if (request->callback)
+        request->callback (window, completed, request->user_data);
+
+    if (request->destroy)
+        request->destroy (request->user_data);
+
+    g_slice_free (HildonScreenshotRequest, request);
+    g_object_unref (window);
+}
+
+static GdkFilterReturn
+screenshot_request_filter                       (GdkXEvent *xevent,
+                                                 GdkEvent  *event,
+                                                 gpointer   data)
+{
+    HildonScreenshotRequest *request = data;
+    XEvent *xev = xevent;
+
+    if (xev->type == ClientMessage
+        && xev->xclient.message_type == hildon_private_get_xatom (gdk_drawable_get_display (request->gdkwin),
+                                                                  HILDON_ATOM_HILDON_LOADING_SCREENSHOT)
+        && xev->xclient.window == GDK_WINDOW_XID (request->gdkwin))
+    {
+        screenshot_request_finish (request, TRUE);
+        return GDK_FILTER_REMOVE;
+    }
+
+    return GDK_FILTER_CONTINUE;
+}
+
+static gboolean
+screenshot_request_timeout                      (gpointer data)
+{
+    HildonScreenshotRequest *request = data;
+
+    request->timeout_id = 0;
+    screenshot_request_finish (request, FALSE);
+
+    return FALSE;
+}
+
+static void
+screenshot_request_unrealized                   (GtkWidget *widget,
+                                                 gpointer   data)
+{
+    screenshot_request_finish (data, FALSE);
+}
+
+static void
+screenshot_request_cancelled                    (GCancellable *cancellable,
+                                                 gpointer      data)
+{
+    screenshot_request_finish (data, FALSE);
+}
+
+/**
+ * hildon_gtk_window_take_screenshot_async:
+ * @window: a #GtkWindow
+ * @take: %TRUE to take a screenshot, %FALSE to destroy the existing one.
+ * @timeout: maximum time to wait for the window manager, in
+ * milliseconds, or 0 to wait until it replies
+ * @cancellable: a #GCancellable to stop waiting for the reply, or %NULL
+ * @callback: function to call when the operation is over, or %NULL
+ * @user_data: data to pass to @callback
+ * @destroy: function to free @user_data, or %NULL
+ *
+ * Like hildon_gtk_window_take_screenshot(), but neither waits for the
+ * X server nor blocks until the window manager replies. The reply is
+ * received through the main loop, so the application can keep working
+ * (for instance, tearing down its state) while the screenshot is taken.
+ *
+ * @callback is called with %TRUE once the window manager has completed
+ * the operation, or with %FALSE if @timeout expires, @window is
+ * unrealized or @cancellable is cancelled. Cancelling only stops
+ * waiting, the window manager may still complete the operation.
+ * @cancellable must be cancelled from the thread running the main loop.
+ * Only one request can be pending for each window; starting a new one
+ * ends the previous one as if it had been cancelled.
+ *
+ * You should only call this method when @window is already mapped.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_gtk_window_take_screenshot_async         (GtkWindow                *window,
+                                                 gboolean                  take,
+                                                 guint                     timeout,
+                                                 GCancellable             *cancellable,
+                                                 HildonScreenshotCallback  callback,
+                                                 gpointer                  user_data,
+                                                 GDestroyNotify            destroy)
+{
+    HildonScreenshotRequest *request;
+
+    g_return_if_fail (GTK_IS_WINDOW (window));
+    g_return_if_fail (GTK_WIDGET_MAPPED (window));
+    g_return_if_fail (cancellable == NULL || G_IS_CANCELLABLE (cancellable));
+
+    /* End the pending request, if any */
+    request = g_object_get_data (G_OBJECT (window), SCREENSHOT_REQUEST_KEY);
+    if (request)
+        screenshot_request_finish (request, FALSE);
+
+    if (cancellable && g_cancellable_is_cancelled (cancellable)) {
+        if (callback)
+            callback (window, FALSE, user_data);
+        if (destroy)
+            destroy (user_data);
+        return;
+    }
+
+    request = g_slice_new0 (HildonScreenshotRequest);
+    request->window = g_object_ref (window);
+    request->gdkwin = g_object_ref (GTK_WIDGET (window)->window);
+    request->callback = callback;
+    request->user_data = user_data;
+    request->destroy = destroy;
+
+    g_object_set_data (G_OBJECT (window), SCREENSHOT_REQUEST_KEY, request);
+
+    gdk_window_add_filter (request->gdkwin, screenshot_request_filter, request);
+    g_signal_connect (window, "unrealize",
+                      G_CALLBACK (screenshot_request_unrealized), request);
+
+    if (timeout > 0)
+        request->timeout_id = gdk_threads_add_timeout (timeout, screenshot_request_timeout, request);
+
+    if (cancellable) {
+        request->cancellable = g_object_ref (cancellable);
+        request->cancelled_id = g_signal_connect (cancellable, "cancelled",
+                                                  G_CALLBACK (screenshot_request_cancelled),
+                                                  request);
+    }
+
+    send_screenshot_message (window, take);
+}
+
 /**
  * hildon_gtk_hscale_new:
  *
@@ -18,6 +18,7 @@
 #define                                         __HILDON_GTK_H__
 
 #include                                        <gtk/gtk.h>
+#include                                        <gio/gio.h>
 
 #ifndef MAEMO_GTK
 #include                                        "maemo-gtk-compat.h"
@@ -110,6 +111,30 @@ void
 hildon_gtk_window_take_screenshot_sync          (GtkWindow *window,
                                                  gboolean   take);
 
+/**
+ * HildonScreenshotCallback:
+ * @window: the #GtkWindow passed to hildon_gtk_window_take_screenshot_async()
+ * @completed: %TRUE if the window manager completed the operation,
+ * %FALSE if the request timed out, was cancelled or was replaced
+ * @user_data: the data passed to hildon_gtk_window_take_screenshot_async()
+ *
+ * Function called when an asynchronous screenshot request is over.
+ *
+ * Since: 2.2.25
+ **/
+typedef void (*HildonScreenshotCallback)        (GtkWindow *window,
+                                                 gboolean   completed,
+                                                 gpointer   user_data);
+
+void
+hildon_gtk_window_take_screenshot_async         (GtkWindow                *window,
+                                                 gboolean                  take,
+                                                 guint                     timeout,
+                                                 GCancellable             *cancellable,
+                                                 HildonScreenshotCallback  callback,
+                                                 gpointer                  user_data,
+                                                 GDestroyNotify            destroy);
+
 void
 hildon_gtk_window_enable_zoom_keys              (GtkWindow *window,
                                                  gboolean   enable);
@@ -41,6 +41,7 @@
 #include                                        <string.h>
 #include                                        "hildon-helper.h"
 #include                                        "hildon-banner.h"
+#include                                        "hildon-private.h"
 
 #define                                         HILDON_FINGER_PRESSURE_THRESHOLD 0.4
 
@@ -177,23 +178,25 @@ attach_new_color_element                        (GtkWidget *widget,
     return style_list;
 }
 
-static void 
-hildon_change_style_recursive_from_list         (GtkWidget *widget, 
-                                                 GtkStyle *prev_style, 
-                                                 GSList *list)
+static void
+hildon_change_style_recursive_from_list         (GtkWidget *widget,
+                                                 GtkStyle *prev_style,
+                                                 GSList *list);
+
+/* Merges the logical colors and font resolved in @changes into the
+ * modifier style of @widget and its children, top-down. Each widget has
+ * its style reset at most once, and only if something changed. */
+static void
+apply_logical_style_recursive                   (GtkWidget  *widget,
+                                                 GtkRcStyle *changes)
 {
-    g_assert (GTK_IS_WIDGET (widget));
+    GtkRcStyle *rc_style;
+    gboolean changed = FALSE;
+    gint state;
 
-    /* Change the style for child widgets */
-    if (GTK_IS_CONTAINER (widget)) {
-        GList *iterator, *children;
-        children = gtk_container_get_children (GTK_CONTAINER (widget));
-        for (iterator = children; iterator != NULL; iterator = g_list_next (iterator))
-            hildon_change_style_recursive_from_list (GTK_WIDGET (iterator->data), prev_style, list);
-        g_list_free (children);
-    }
+    g_assert (GTK_IS_WIDGET (widget));
 
-    /* gtk_widget_modify_*() emit "style_set" signals, so if we got here from
+    /* gtk_widget_modify_style() emits "style_set", so if we got here from
        "style_set" signal, we need to block this function from being called
        again or we get into inifinite loop.
 
@@ -211,63 +214,88 @@ hildon_change_style_recursive_from_list         (GtkWidget *widget,
                 (gpointer) hildon_change_style_recursive_from_list,
                 NULL);
 
-    /* We iterate over all list elements and apply each style
-     * specification. */
+    rc_style = gtk_widget_get_modifier_style (widget);
+
+    for (state = GTK_STATE_NORMAL; state <= GTK_STATE_INSENSITIVE; state++) {
+        GtkRcFlags flags = changes->color_flags[state];
+
+        if (flags & GTK_RC_FG)
+            changed |= hildon_private_modifier_set_color (rc_style, GTK_RC_FG, state,
+                                                          &changes->fg[state]);
+        if (flags & GTK_RC_BG)
+            changed |= hildon_private_modifier_set_color (rc_style, GTK_RC_BG, state,
+                                                          &changes->bg[state]);
+        if (flags & GTK_RC_TEXT)
+            changed |= hildon_private_modifier_set_color (rc_style, GTK_RC_TEXT, state,
+                                                          &changes->text[state]);
+        if (flags & GTK_RC_BASE)
+            changed |= hildon_private_modifier_set_color (rc_style, GTK_RC_BASE, state,
+                                                          &changes->base[state]);
+    }
 
-    GSList *iterator = list;
-    while (iterator) {
-    
+    if (changes->font_desc != NULL)
+        changed |= hildon_private_modifier_set_font (rc_style, changes->font_desc);
+
+    /* A single style reset for all the logical elements */
+    if (changed)
+        gtk_widget_modify_style (widget, rc_style);
+
+    /* FIXME: Compilation workaround for gcc > 3.3 + -pedantic again */
+
+    G_GNUC_EXTENSION
+        g_signal_handlers_unblock_matched (G_OBJECT (widget), G_SIGNAL_MATCH_ID | G_SIGNAL_MATCH_FUNC,
+                g_signal_lookup ("style_set", G_TYPE_FROM_INSTANCE (widget)),
+                0, NULL,
+                (gpointer) hildon_change_style_recursive_from_list,
+                NULL);
+
+    /* Change the style for child widgets */
+    if (GTK_IS_CONTAINER (widget)) {
+        GList *iterator, *children;
+        children = gtk_container_get_children (GTK_CONTAINER (widget));
+        for (iterator = children; iterator != NULL; iterator = g_list_next (iterator))
+            apply_logical_style_recursive (GTK_WIDGET (iterator->data), changes);
+        g_list_free (children);
+    }
+}
+
+static void 
+hildon_change_style_recursive_from_list         (GtkWidget *widget, 
+                                                 GtkStyle *prev_style, 
+                                                 GSList *list)
+{
+    GtkRcStyle *changes;
+    GSList *iterator;
+
+    g_assert (GTK_IS_WIDGET (widget));
+
+    /* Resolve every logical name once, against the style of the widget
+     * the elements were set on, then apply the result to the subtree. */
+    changes = gtk_rc_style_new ();
+
+    for (iterator = list; iterator != NULL; iterator = iterator->next) {
         HildonLogicalElement *element = (HildonLogicalElement *) iterator->data;
 
         if (element->is_color == TRUE) {
 
             /* Changing logical color */
             GdkColor color;
-            gtk_widget_ensure_style (widget);
-            if (gtk_style_lookup_color (widget->style, element->logical_color_name, &color) == TRUE) {
-               
-                switch (element->rc_flags)
-                {
-                    case GTK_RC_FG:
-                        gtk_widget_modify_fg (widget, element->state, &color);
-                        break;
-
-                    case GTK_RC_BG:
-                        gtk_widget_modify_bg (widget, element->state, &color);
-                        break;
-
-                    case GTK_RC_TEXT:
-                        gtk_widget_modify_text (widget, element->state, &color);
-                        break;
-
-                    case GTK_RC_BASE:
-                        gtk_widget_modify_base (widget, element->state, &color);
-                        break;
-                }
-            }
+            if (hildon_private_get_logical_color (widget, element->logical_color_name, &color))
+                hildon_private_modifier_set_color (changes, element->rc_flags,
+                                                   element->state, &color);
         } else {
-            
-            /* Changing logical font */
-            GtkStyle *font_style = gtk_rc_get_style_by_paths (gtk_settings_get_default (), element->logical_font_name, NULL, G_TYPE_NONE);
-            if (font_style != NULL) {
-                PangoFontDescription *font_desc = font_style->font_desc;
 
-                if (font_desc != NULL)
-                    gtk_widget_modify_font (widget, font_desc);
-            }
+            /* Changing logical font */
+            const PangoFontDescription *font_desc;
+            font_desc = hildon_private_get_logical_font (element->logical_font_name);
+            if (font_desc != NULL)
+                hildon_private_modifier_set_font (changes, font_desc);
         }
+    }
 
-        iterator = iterator->next;
-    } 
+    apply_logical_style_recursive (widget, changes);
 
-    /* FIXME: Compilation workaround for gcc > 3.3 + -pedantic again */
-
-    G_GNUC_EXTENSION
-        g_signal_handlers_unblock_matched (G_OBJECT (widget), G_SIGNAL_MATCH_ID | G_SIGNAL_MATCH_FUNC,
-                g_signal_lookup ("style_set", G_TYPE_FROM_INSTANCE (widget)),
-                0, NULL,
-                (gpointer) hildon_change_style_recursive_from_list,
-                NULL);
+    g_object_unref (changes);
 }
 
 /**
@@ -99,6 +99,7 @@
 #include                                        "hildon-gtk.h"
 #include                                        "hildon-enum-types.h"
 #include                                        "hildon-note-private.h"
+#include                                        "hildon-private.h"
 
 #define                                         HILDON_INFORMATION_NOTE_MIN_HEIGHT 140
 
@@ -165,6 +166,9 @@ on_show_cb                                      (GtkWidget *widget,
 static gboolean
 sound_handling                                  (gpointer data);
 
+static gboolean
+cache_sounds                                    (gpointer data);
+
 static void
 unpack_widget                                   (GtkWidget *widget);
 
@@ -372,6 +376,11 @@ hildon_note_class_init                          (HildonNoteClass *class)
     widget_class->unrealize     = hildon_note_unrealize;
     widget_class->size_request  = hildon_note_size_request;
 
+    /* Upload the note sounds once per process. The upload blocks, so it
+     * runs below redraw priority and never delays painting a note; a
+     * note shown before it finishes plays its sound uncached */
+    gdk_threads_add_idle_full (G_PRIORITY_LOW, cache_sounds, NULL, NULL);
+
     /**
      * HildonNote:type:
      *
@@ -621,7 +630,7 @@ hildon_note_realize                             (GtkWidget *widget)
 
     /* Set the _HILDON_NOTIFICATION_TYPE property so Matchbox places the window correctly */
     display = gdk_drawable_get_display (widget->window);
-    atom = gdk_x11_get_xatom_by_name_for_display (display, "_HILDON_NOTIFICATION_TYPE");
+    atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_NOTIFICATION_TYPE);
 
     if (priv->note_n == HILDON_NOTE_TYPE_INFORMATION ||
         priv->note_n == HILDON_NOTE_TYPE_INFORMATION_THEME) {
@@ -1157,6 +1166,15 @@ on_show_cb                                      (GtkWidget *widget,
     priv->idle_handler = gdk_threads_add_idle (sound_handling, widget);
 }
 
+static gboolean
+cache_sounds                                    (gpointer data)
+{
+    hildon_sound_cache_sample (INFORMATION_SOUND_PATH);
+    hildon_sound_cache_sample (CONFIRMATION_SOUND_PATH);
+
+    return FALSE;
+}
+
 /* We play a system sound when the note comes visible */
 static gboolean
 sound_handling                                  (gpointer data)
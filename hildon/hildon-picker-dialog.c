@@ -50,6 +50,7 @@
 
 #include "hildon-touch-selector.h"
 #include "hildon-touch-selector-entry.h"
+#include "hildon-touch-selector-private.h"
 #include "hildon-picker-dialog.h"
 
 #define _(String)  dgettext("hildon-libs", String)
@@ -67,8 +68,12 @@ struct _HildonPickerDialogPrivate
   gulong signal_columns_changed_id;
 
   gboolean center_on_show;
-  GSList *current_selection;
+  HildonTouchSelectorSnapshot *current_selection;
   gchar *current_text;
+
+  /* Maximum height of the dialog for the geometry of max_height_screen */
+  guint max_height;
+  GdkScreen *max_height_screen;
 };
 
 /* properties */
@@ -113,6 +118,10 @@ static void
 hildon_picker_dialog_size_request               (GtkWidget *widget,
                                                  GtkRequisition *requisition);
 
+static void
+hildon_picker_dialog_style_set                  (GtkWidget *widget,
+                                                 GtkStyle *previous_style);
+
 /* private functions */
 static gboolean
 requires_done_button                            (HildonPickerDialog * dialog);
@@ -177,6 +186,7 @@ hildon_picker_dialog_class_init (HildonPickerDialogClass * class)
   widget_class->show = hildon_picker_dialog_show;
   widget_class->realize = hildon_picker_dialog_realize;
   widget_class->size_request = hildon_picker_dialog_size_request,
+  widget_class->style_set = hildon_picker_dialog_style_set;
 
   /* HildonPickerDialog */
   class->set_selector = _hildon_picker_dialog_set_selector;
@@ -255,6 +265,8 @@ hildon_picker_dialog_init (HildonPickerDialog * dialog)
   dialog->priv->center_on_show = TRUE;
   dialog->priv->current_selection = NULL;
   dialog->priv->current_text = NULL;
+  dialog->priv->max_height = 0;
+  dialog->priv->max_height_screen = NULL;
 
   g_signal_connect (G_OBJECT (dialog),
                     "response", G_CALLBACK (_on_dialog_response),
@@ -379,6 +391,27 @@ hildon_picker_dialog_size_request               (GtkWidget *widget,
       (widget, requisition);
 }
 
+static void
+hildon_picker_dialog_invalidate_max_height      (HildonPickerDialog *dialog)
+{
+  if (dialog->priv->max_height_screen != NULL) {
+    g_signal_handlers_disconnect_by_func (dialog->priv->max_height_screen,
+                                          hildon_picker_dialog_invalidate_max_height,
+                                          dialog);
+    dialog->priv->max_height_screen = NULL;
+  }
+}
+
+static void
+hildon_picker_dialog_style_set                  (GtkWidget *widget,
+                                                 GtkStyle *previous_style)
+{
+  /* The maximum heights are style properties */
+  hildon_picker_dialog_invalidate_max_height (HILDON_PICKER_DIALOG (widget));
+
+  GTK_WIDGET_CLASS (hildon_picker_dialog_parent_class)->style_set (widget, previous_style);
+}
+
 static void
 hildon_picker_dialog_realize (GtkWidget *widget)
 {
@@ -399,6 +432,14 @@ hildon_picker_dialog_get_max_height             (HildonPickerDialog *dialog)
   GdkScreen *screen = NULL;
 
   screen = gtk_widget_get_screen (GTK_WIDGET (dialog));
+
+  /* The value is kept until the screen geometry, the screen of the
+     dialog or its style change */
+  if (screen != NULL && screen == dialog->priv->max_height_screen)
+    return dialog->priv->max_height;
+
+  hildon_picker_dialog_invalidate_max_height (dialog);
+
   if (screen != NULL) {
     if (gdk_screen_get_width (screen) > gdk_screen_get_height (screen)) {
       landscape = TRUE;
@@ -415,6 +456,14 @@ hildon_picker_dialog_get_max_height             (HildonPickerDialog *dialog)
                           &max_value, NULL);
   }
 
+  if (screen != NULL) {
+    dialog->priv->max_height = max_value;
+    dialog->priv->max_height_screen = screen;
+    g_signal_connect_object (screen, "size-changed",
+                             G_CALLBACK (hildon_picker_dialog_invalidate_max_height),
+                             dialog, G_CONNECT_SWAPPED);
+  }
+
   return max_value;
 }
 
@@ -565,19 +614,11 @@ hildon_picker_dialog_get_done_label (HildonPickerDialog * dialog)
   return gtk_button_get_label (GTK_BUTTON (priv->button));
 }
 
-static void
-free_path_list (GList *list)
-{
-  g_list_foreach (list, (GFunc) gtk_tree_path_free, NULL);
-  g_list_free (list);
-}
-
 static void
 _clean_current_selection (HildonPickerDialog *dialog)
 {
   if (dialog->priv->current_selection) {
-    g_slist_foreach (dialog->priv->current_selection, (GFunc) free_path_list, NULL);
-    g_slist_free (dialog->priv->current_selection);
+    hildon_touch_selector_snapshot_free (dialog->priv->current_selection);
     dialog->priv->current_selection = NULL;
   }
   if (dialog->priv->current_text) {
@@ -590,18 +631,15 @@ static void
 _save_current_selection (HildonPickerDialog *dialog)
 {
   HildonTouchSelector *selector;
-  gint i, columns;
 
   selector = HILDON_TOUCH_SELECTOR (dialog->priv->selector);
 
-  _clean_current_selection (dialog);
+  /* The previous snapshot is reused if the selection did not change */
+  dialog->priv->current_selection
+    = hildon_touch_selector_snapshot_selection (selector, dialog->priv->current_selection);
 
-  columns = hildon_touch_selector_get_num_columns (selector);
-  for (i = 0; i  < columns; i++) {
-    dialog->priv->current_selection
-      = g_slist_append (dialog->priv->current_selection,
-                        hildon_touch_selector_get_selected_rows (selector, i));
-  }
+  g_free (dialog->priv->current_text);
+  dialog->priv->current_text = NULL;
   if (HILDON_IS_TOUCH_SELECTOR_ENTRY (selector)) {
 	  HildonEntry *entry = hildon_touch_selector_entry_get_entry (HILDON_TOUCH_SELECTOR_ENTRY (selector));
 	  dialog->priv->current_text = g_strdup (gtk_entry_get_text (GTK_ENTRY (entry)));
@@ -611,45 +649,27 @@ _save_current_selection (HildonPickerDialog *dialog)
 static void
 _restore_current_selection (HildonPickerDialog *dialog)
 {
-  GSList *current_selection, *iter;
-  GList *selected, *selected_iter;
-  GtkTreePath *current_path;
   HildonTouchSelector *selector;
-  GtkTreeModel *model;
-  GtkTreeIter tree_iter;
-  gint i;
+  gboolean restored;
 
   if (dialog->priv->current_selection == NULL)
     return;
 
-  current_selection = dialog->priv->current_selection;
   selector = HILDON_TOUCH_SELECTOR (dialog->priv->selector);
 
-  if (hildon_touch_selector_get_num_columns (selector) !=
-      g_slist_length (current_selection)) {
-    /* We conclude that if the current selection has the same
-       numbers of columns that the selector, all this ok
+  if (dialog->priv->signal_changed_id)
+    g_signal_handler_block (selector, dialog->priv->signal_changed_id);
+
+  restored = hildon_touch_selector_restore_selection (selector, dialog->priv->current_selection);
+  if (restored == FALSE) {
+    /* The snapshot is only valid for the columns it was taken from.
        Anyway this shouldn't happen. */
     g_critical ("Trying to restore the selection on a selector after change"
                 " the number of columns. Are you removing columns while the"
                 " dialog is open?");
-    return;
   }
 
-  if (dialog->priv->signal_changed_id)
-    g_signal_handler_block (selector, dialog->priv->signal_changed_id);
-  for (iter = current_selection, i = 0; iter; iter = g_slist_next (iter), i++) {
-    selected = (GList *) (iter->data);
-    model = hildon_touch_selector_get_model (selector, i);
-    if (selected)
-        hildon_touch_selector_unselect_all (selector, i);
-    for (selected_iter = selected; selected_iter; selected_iter = g_list_next (selected_iter)) {
-      current_path = (GtkTreePath *) selected_iter->data;
-      if (gtk_tree_model_get_iter (model, &tree_iter, current_path))
-          hildon_touch_selector_select_iter (selector, i, &tree_iter, FALSE);
-    }
-  }
-  if (HILDON_IS_TOUCH_SELECTOR_ENTRY (selector) && dialog->priv->current_text != NULL) {
+  if (restored && HILDON_IS_TOUCH_SELECTOR_ENTRY (selector) && dialog->priv->current_text != NULL) {
     HildonEntry *entry = hildon_touch_selector_entry_get_entry (HILDON_TOUCH_SELECTOR_ENTRY (selector));
     gtk_entry_set_text (GTK_ENTRY (entry), dialog->priv->current_text);
   }
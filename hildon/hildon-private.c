@@ -80,19 +80,29 @@ hildon_private_composite_focus                  (GtkWidget *widget,
 }
 
 
-G_GNUC_INTERNAL GtkWidget *
-hildon_private_create_animation                 (gfloat       framerate,
+/* Decoded frame sets, shared by all the animations created with the
+ * same parameters. GtkImage gets its own iterator for each image, so
+ * the animation object itself can be shared. */
+static GHashTable *animation_cache = NULL;
+
+static void
+animation_cache_icon_theme_changed              (GtkIconTheme *theme,
+                                                 gpointer      data)
+{
+    g_hash_table_remove_all (animation_cache);
+}
+
+static GdkPixbufAnimation *
+load_animation                                  (gfloat       framerate,
                                                  const gchar *template,
-                                                 gint         nframes)
+                                                 gint         nframes,
+                                                 gint         size)
 {
-    GtkWidget *image;
     GdkPixbufSimpleAnim *anim;
     GtkIconTheme *theme;
     gint i;
 
-    anim = gdk_pixbuf_simple_anim_new (HILDON_ICON_PIXEL_SIZE_STYLUS,
-                                       HILDON_ICON_PIXEL_SIZE_STYLUS,
-                                       framerate);
+    anim = gdk_pixbuf_simple_anim_new (size, size, framerate);
     gdk_pixbuf_simple_anim_set_loop (anim, TRUE);
     theme = gtk_icon_theme_get_default ();
 
@@ -100,8 +110,7 @@ hildon_private_create_animation                 (gfloat       framerate,
         GdkPixbuf *frame;
         GError *error = NULL;
         gchar *icon_name = g_strdup_printf (template, i);
-        frame = gtk_icon_theme_load_icon (theme, icon_name,
-                                          HILDON_ICON_PIXEL_SIZE_STYLUS,
+        frame = gtk_icon_theme_load_icon (theme, icon_name, size,
                                           0, &error);
 
         if (error) {
@@ -110,18 +119,288 @@ hildon_private_create_animation                 (gfloat       framerate,
             g_error_free (error);
         } else {
             gdk_pixbuf_simple_anim_add_frame (anim, frame);
+            g_object_unref (frame);
         }
 
-        g_object_unref (frame);
         g_free (icon_name);
     }
 
-    image = gtk_image_new_from_animation (GDK_PIXBUF_ANIMATION (anim));
-    g_object_unref (anim);
+    return GDK_PIXBUF_ANIMATION (anim);
+}
+
+G_GNUC_INTERNAL GtkWidget *
+hildon_private_create_animation                 (gfloat       framerate,
+                                                 const gchar *template,
+                                                 gint         nframes)
+{
+    GdkPixbufAnimation *anim;
+    gchar *key;
+
+    if (G_UNLIKELY (animation_cache == NULL)) {
+        animation_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, g_object_unref);
+        g_signal_connect (gtk_icon_theme_get_default (), "changed",
+                          G_CALLBACK (animation_cache_icon_theme_changed), NULL);
+    }
+
+    key = g_strdup_printf ("%s:%d:%d:%g", template, nframes,
+                           HILDON_ICON_PIXEL_SIZE_STYLUS, framerate);
+    anim = g_hash_table_lookup (animation_cache, key);
+
+    if (anim == NULL) {
+        anim = load_animation (framerate, template, nframes,
+                               HILDON_ICON_PIXEL_SIZE_STYLUS);
+        g_hash_table_insert (animation_cache, key, anim);
+    } else {
+        g_free (key);
+    }
+
+    return gtk_image_new_from_animation (anim);
+}
+
+/* Logical fonts resolved for the current theme. The table also keeps
+ * names the theme doesn't define, with a NULL value. It belongs to the
+ * theme, font and color scheme in logical_fonts_theme, which are
+ * checked on every lookup: GTK+ restyles the widgets from its own
+ * GtkSettings notify handlers, before any handler of ours could
+ * invalidate the table. */
+static GHashTable *logical_fonts = NULL;
+static gchar *logical_fonts_theme = NULL;
+
+/* Logical colors are resolved per style, so they are cached on the
+ * GtkStyle, which is replaced when the theme changes */
+static GQuark logical_colors_quark = 0;
+
+static gchar *
+logical_cache_get_theme                         (void)
+{
+    gchar *theme, *font, *scheme, *key;
+
+    g_object_get (gtk_settings_get_default (),
+                  "gtk-theme-name", &theme,
+                  "gtk-font-name", &font,
+                  "gtk-color-scheme", &scheme,
+                  NULL);
 
-    return image;
+    key = g_strdup_printf ("%s\n%s\n%s", theme ? theme : "",
+                           font ? font : "", scheme ? scheme : "");
+
+    g_free (theme);
+    g_free (font);
+    g_free (scheme);
+
+    return key;
 }
 
+static void
+logical_fonts_validate                          (void)
+{
+    gchar *theme = logical_cache_get_theme ();
+
+    if (G_UNLIKELY (logical_fonts == NULL))
+        logical_fonts = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                               (GDestroyNotify) pango_font_description_free);
+
+    if (logical_fonts_theme != NULL && g_str_equal (theme, logical_fonts_theme)) {
+        g_free (theme);
+        return;
+    }
+
+    g_hash_table_remove_all (logical_fonts);
+    g_free (logical_fonts_theme);
+    logical_fonts_theme = theme;
+}
+
+static void
+logical_color_free                              (gpointer color)
+{
+    if (color != NULL)
+        gdk_color_free (color);
+}
+
+/* Returns the font description of the logical font @name in the
+ * current theme, or %NULL. The description is owned by the cache and
+ * is only valid until the theme changes. */
+G_GNUC_INTERNAL const PangoFontDescription *
+hildon_private_get_logical_font                 (const gchar *name)
+{
+    PangoFontDescription *font_desc = NULL;
+    GtkStyle *style;
+    gpointer key, value;
+
+    logical_fonts_validate ();
+
+    if (g_hash_table_lookup_extended (logical_fonts, name, &key, &value))
+        return value;
+
+    style = gtk_rc_get_style_by_paths (gtk_settings_get_default (),
+                                       name, NULL, G_TYPE_NONE);
+    if (style != NULL && style->font_desc != NULL)
+        font_desc = pango_font_description_copy (style->font_desc);
+
+    g_hash_table_insert (logical_fonts, g_strdup (name), font_desc);
+
+    return font_desc;
+}
+
+/* Looks up the logical color @name in the style of @widget. Results,
+ * including colors that are not found, are cached on the style. */
+G_GNUC_INTERNAL gboolean
+hildon_private_get_logical_color                (GtkWidget   *widget,
+                                                 const gchar *name,
+                                                 GdkColor    *color)
+{
+    GHashTable *colors;
+    gpointer key, value;
+
+    if (G_UNLIKELY (logical_colors_quark == 0))
+        logical_colors_quark = g_quark_from_static_string ("hildon-logical-colors");
+
+    gtk_widget_ensure_style (widget);
+
+    colors = g_object_get_qdata (G_OBJECT (widget->style), logical_colors_quark);
+    if (colors == NULL) {
+        colors = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, logical_color_free);
+        g_object_set_qdata_full (G_OBJECT (widget->style), logical_colors_quark,
+                                 colors, (GDestroyNotify) g_hash_table_destroy);
+    }
+
+    if (!g_hash_table_lookup_extended (colors, name, &key, &value)) {
+        value = NULL;
+        if (gtk_style_lookup_color (widget->style, name, color))
+            value = gdk_color_copy (color);
+        g_hash_table_insert (colors, g_strdup (name), value);
+    }
+
+    if (value == NULL)
+        return FALSE;
+
+    *color = *(GdkColor *) value;
+
+    return TRUE;
+}
+
+/* Sets a color of a modifier style. Returns FALSE if it was already set
+ * to @color, so callers can avoid resetting the style of the widget */
+G_GNUC_INTERNAL gboolean
+hildon_private_modifier_set_color               (GtkRcStyle     *rc_style,
+                                                 GtkRcFlags      component,
+                                                 GtkStateType    state,
+                                                 const GdkColor *color)
+{
+    GdkColor *target;
+
+    switch (component) {
+    case GTK_RC_FG:
+        target = &rc_style->fg[state];
+        break;
+    case GTK_RC_BG:
+        target = &rc_style->bg[state];
+        break;
+    case GTK_RC_TEXT:
+        target = &rc_style->text[state];
+        break;
+    case GTK_RC_BASE:
+        target = &rc_style->base[state];
+        break;
+    default:
+        return FALSE;
+    }
+
+    if ((rc_style->color_flags[state] & component) && gdk_color_equal (target, color))
+        return FALSE;
+
+    *target = *color;
+    rc_style->color_flags[state] |= component;
+
+    return TRUE;
+}
+
+/* Same as hildon_private_modifier_set_color(), for the font */
+G_GNUC_INTERNAL gboolean
+hildon_private_modifier_set_font                (GtkRcStyle                 *rc_style,
+                                                 const PangoFontDescription *font_desc)
+{
+    if (rc_style->font_desc != NULL &&
+        pango_font_description_equal (rc_style->font_desc, font_desc))
+        return FALSE;
+
+    if (rc_style->font_desc != NULL)
+        pango_font_description_free (rc_style->font_desc);
+    rc_style->font_desc = pango_font_description_copy (font_desc);
+
+    return TRUE;
+}
+
+static const gchar *hildon_atom_names[HILDON_N_ATOMS] = {
+    "_NET_WM_WINDOW_TYPE",
+    "_NET_WM_CONTEXT_CUSTOM",
+    "_MB_CURRENT_APP_WINDOW",
+    "_MB_GRAB_TRANSFER",
+    "_HILDON_IM_CLIPBOARD_COPY",
+    "_HILDON_IM_CLIPBOARD_CUT",
+    "_HILDON_IM_CLIPBOARD_PASTE",
+    "_HILDON_LOADING_SCREENSHOT",
+    "_HILDON_STACKABLE_WINDOW",
+    "_HILDON_NOTIFICATION_TYPE",
+    "_HILDON_WM_WINDOW_TYPE_APP_MENU",
+    "_HILDON_WM_WINDOW_TYPE_ANIMATION_ACTOR",
+    "_HILDON_WM_WINDOW_TYPE_REMOTE_TEXTURE",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_SHOW",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_ANCHOR",
+    "_HILDON_ANIMATION_CLIENT_MESSAGE_PARENT",
+    "_HILDON_ANIMATION_CLIENT_READY",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_SHM",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_DAMAGE",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_SHOW",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_POSITION",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_OFFSET",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_SCALE",
+    "_HILDON_TEXTURE_CLIENT_MESSAGE_PARENT",
+    "_HILDON_TEXTURE_CLIENT_READY",
+    "_HILDON_PORTRAIT_MODE_SUPPORT",
+    "_HILDON_DO_NOT_DISTURB_OVERRIDE",
+    "_HILDON_WM_NAME",
+    "UTF8_STRING",
+    "_HILDON_ABLE_TO_HIBERNATE",
+    "_HILDON_WM_WINDOW_TYPE",
+    "_HILDON_WM_WINDOW_TYPE_LEGACY_MENU"
+};
+
+/* Returns the X atom for @atom on @display (or the default display if
+ * %NULL). All the hildon atoms of a display are interned in a single
+ * request the first time any of them is needed, so event filters can
+ * compare against them without a round trip to the server. */
+Atom G_GNUC_INTERNAL
+hildon_private_get_xatom                        (GdkDisplay *display,
+                                                 HildonAtom  atom)
+{
+    static GQuark quark = 0;
+    Atom *atoms;
+
+    g_return_val_if_fail (atom < HILDON_N_ATOMS, None);
+
+    if (display == NULL)
+        display = gdk_display_get_default ();
+
+    if (G_UNLIKELY (quark == 0))
+        quark = g_quark_from_static_string ("hildon-private-xatoms");
+
+    atoms = g_object_get_qdata (G_OBJECT (display), quark);
+
+    if (G_UNLIKELY (atoms == NULL))
+    {
+        atoms = g_new (Atom, HILDON_N_ATOMS);
+        XInternAtoms (GDK_DISPLAY_XDISPLAY (display), (char **) hildon_atom_names,
+                      HILDON_N_ATOMS, False, atoms);
+        g_object_set_qdata_full (G_OBJECT (display), quark, atoms, g_free);
+    }
+
+    return atoms[atom];
+}
 
 void
 hildon_gtk_window_set_clear_window_flag                           (GtkWindow   *window,
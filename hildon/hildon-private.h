@@ -58,6 +58,69 @@ hildon_gtk_window_set_flag                                        (GtkWindow
                                                                    HildonFlagFunc  func,
                                                                    gpointer        userdata);
 
+/* X atoms used by hildon. Keep in sync with hildon_atom_names[] */
+typedef enum
+{
+    HILDON_ATOM_NET_WM_WINDOW_TYPE,
+    HILDON_ATOM_NET_WM_CONTEXT_CUSTOM,
+    HILDON_ATOM_MB_CURRENT_APP_WINDOW,
+    HILDON_ATOM_MB_GRAB_TRANSFER,
+    HILDON_ATOM_HILDON_IM_CLIPBOARD_COPY,
+    HILDON_ATOM_HILDON_IM_CLIPBOARD_CUT,
+    HILDON_ATOM_HILDON_IM_CLIPBOARD_PASTE,
+    HILDON_ATOM_HILDON_LOADING_SCREENSHOT,
+    HILDON_ATOM_HILDON_STACKABLE_WINDOW,
+    HILDON_ATOM_HILDON_NOTIFICATION_TYPE,
+    HILDON_ATOM_HILDON_WM_WINDOW_TYPE_APP_MENU,
+    HILDON_ATOM_HILDON_WM_WINDOW_TYPE_ANIMATION_ACTOR,
+    HILDON_ATOM_HILDON_WM_WINDOW_TYPE_REMOTE_TEXTURE,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_SHOW,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_ANCHOR,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_MESSAGE_PARENT,
+    HILDON_ATOM_HILDON_ANIMATION_CLIENT_READY,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SHM,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_DAMAGE,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SHOW,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_POSITION,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_OFFSET,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SCALE,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_PARENT,
+    HILDON_ATOM_HILDON_TEXTURE_CLIENT_READY,
+    HILDON_ATOM_HILDON_PORTRAIT_MODE_SUPPORT,
+    HILDON_ATOM_HILDON_DO_NOT_DISTURB_OVERRIDE,
+    HILDON_ATOM_HILDON_WM_NAME,
+    HILDON_ATOM_UTF8_STRING,
+    HILDON_ATOM_HILDON_ABLE_TO_HIBERNATE,
+    HILDON_ATOM_HILDON_WM_WINDOW_TYPE,
+    HILDON_ATOM_HILDON_WM_WINDOW_TYPE_LEGACY_MENU,
+    HILDON_N_ATOMS
+} HildonAtom;
+
+G_GNUC_INTERNAL Atom
+hildon_private_get_xatom                        (GdkDisplay *display,
+                                                 HildonAtom  atom);
+
+G_GNUC_INTERNAL const PangoFontDescription *
+hildon_private_get_logical_font                 (const gchar *name);
+
+G_GNUC_INTERNAL gboolean
+hildon_private_get_logical_color                (GtkWidget   *widget,
+                                                 const gchar *name,
+                                                 GdkColor    *color);
+
+G_GNUC_INTERNAL gboolean
+hildon_private_modifier_set_color               (GtkRcStyle     *rc_style,
+                                                 GtkRcFlags      component,
+                                                 GtkStateType    state,
+                                                 const GdkColor *color);
+
+G_GNUC_INTERNAL gboolean
+hildon_private_modifier_set_font                (GtkRcStyle                 *rc_style,
+                                                 const PangoFontDescription *font_desc);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_PRIVATE_H__ */
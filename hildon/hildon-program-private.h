@@ -47,6 +47,9 @@ struct                                          _HildonProgramPrivate
     GSList *windows;
 };
 
+void G_GNUC_INTERNAL
+hildon_program_update_top_most                  (HildonProgram *program);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_PROGRAM_PRIVATE_H__ */
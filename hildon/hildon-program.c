@@ -333,49 +333,33 @@ hildon_program_window_list_is_is_topmost        (gpointer data,
 }
 
 /*
- * Check the _MB_CURRENT_APP_WINDOW on the root window, and update
+ * Check the topped window tracked from _MB_CURRENT_APP_WINDOW, and update
  * the top_most status accordingly
  */
-static void
+void
 hildon_program_update_top_most                  (HildonProgram *program)
 {
     gboolean is_topmost;
     Window active_window;
+    XID active_group;
     HildonProgramPrivate *priv;
 
     priv = HILDON_PROGRAM_GET_PRIVATE (program);
     g_assert (priv);
-    
-    active_window = hildon_window_get_active_window();
+
+    hildon_window_get_topmost_info (&active_window, &active_group);
     is_topmost = FALSE;
 
-    if (active_window)
+    if (active_group != None)
     {
-      gint xerror;
-      XWMHints *wm_hints;
-      
-      gdk_error_trap_push ();
-      wm_hints = XGetWMHints (GDK_DISPLAY (), active_window);
-      xerror = gdk_error_trap_pop ();
-      if (xerror && xerror != BadWindow)
-      {
-        if (wm_hints)
-          XFree (wm_hints);
-        return;
-      }
-
-      if (wm_hints)
-      {
         GSList *iter;
         for (iter = priv->windows ; iter && !is_topmost; iter = iter->next)
           {
             GdkWindow *gdkwin = GTK_WIDGET (iter->data)->window;
             GdkWindow *group = gdkwin ? gdk_window_get_group (gdkwin) : NULL;
             if (group)
-              is_topmost = wm_hints->window_group == GDK_WINDOW_XID (group);
+              is_topmost = active_group == GDK_WINDOW_XID (group);
           }
-        XFree (wm_hints);
-      }
     }
 
     /* Send notification if is_topmost has changed */
@@ -390,34 +374,6 @@ hildon_program_update_top_most                  (HildonProgram *program)
             (GFunc)hildon_program_window_list_is_is_topmost, &active_window);
 }
 
-/*
- * We keep track of the _MB_CURRENT_APP_WINDOW property on the root window,
- * to detect when a window belonging to this program was is_topmost. This
- * is based on the window group WM hint.
- */
-static GdkFilterReturn
-hildon_program_root_window_event_filter         (GdkXEvent *xevent,
-                                                 GdkEvent *event,
-                                                 gpointer data)
-{
-    XAnyEvent *eventti = xevent;
-    HildonProgram *program = HILDON_PROGRAM (data);
-    Atom active_app_atom =
-            XInternAtom (GDK_DISPLAY (), "_MB_CURRENT_APP_WINDOW", False);
-
-    if (eventti->type == PropertyNotify)
-    {
-        XPropertyEvent *pevent = xevent;
-
-        if (pevent->atom == active_app_atom)
-        {
-            hildon_program_update_top_most (program);
-        }
-    }
-
-    return GDK_FILTER_CONTINUE;
-}
-
 static void
 hildon_program_window_set_common_menu_flag (HildonWindow *window,
                                             gboolean common_menu)
@@ -478,8 +434,13 @@ hildon_program_get_instance                     (void)
     return program;
 }
 
+/*
+ * Changes of _MB_CURRENT_APP_WINDOW are picked up by the event filter of
+ * the window, which updates the program through the shared tracker of the
+ * topped window. Make sure the window gets those events.
+ */
 static void
-window_add_event_filter                         (GtkWidget     *widget,
+window_select_property_events                   (GtkWidget     *widget,
                                                  HildonProgram *program)
 {
     GdkWindow *gdk_window = gtk_widget_get_window (widget);
@@ -488,10 +449,7 @@ window_add_event_filter                         (GtkWidget     *widget,
     gdk_window_set_events (gdk_window,
                            gdk_window_get_events (gdk_window) | GDK_PROPERTY_CHANGE_MASK);
 
-    gdk_window_add_filter (gdk_window,
-                           hildon_program_root_window_event_filter, program);
-
-    g_signal_handlers_disconnect_by_func (widget, G_CALLBACK (window_add_event_filter),
+    g_signal_handlers_disconnect_by_func (widget, G_CALLBACK (window_select_property_events),
                                           program);
 }
 
@@ -530,12 +488,12 @@ hildon_program_add_window                       (HildonProgram *self,
      * the root window */
     if (GTK_WIDGET_REALIZED (window))
     {
-        window_add_event_filter (GTK_WIDGET (window), self);
+        window_select_property_events (GTK_WIDGET (window), self);
     }
     else
     {
         g_signal_connect_after (window, "realize",
-                                G_CALLBACK (window_add_event_filter), self);
+                                G_CALLBACK (window_select_property_events), self);
     }
 
     hildon_window_set_can_hibernate_property (window, &priv->killable);
@@ -578,13 +536,6 @@ hildon_program_remove_window                    (HildonProgram *self,
 
     priv->window_count --;
 
-    if (GTK_WIDGET_REALIZED (window))
-    {
-        gdk_window_remove_filter (gtk_widget_get_window (GTK_WIDGET (window)),
-                                  hildon_program_root_window_event_filter,
-                                  self);
-    }
-
     if (priv->common_menu || priv->common_app_menu)
         hildon_program_window_set_common_menu_flag (window, FALSE);
 }
@@ -785,6 +736,7 @@ hildon_program_set_common_app_menu              (HildonProgram *self,
         g_signal_connect (menu, "changed",
                           G_CALLBACK (hildon_program_on_common_app_menu_changed), self);
         g_object_ref_sink (menu);
+        hildon_app_menu_prepare (menu);
     }
 
     /* Hide and unref old menu */
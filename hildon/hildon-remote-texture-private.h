@@ -33,10 +33,21 @@ G_BEGIN_DECLS
 
 typedef struct                                  _HildonRemoteTexturePrivate HildonRemoteTexturePrivate;
 
+typedef struct                                  _HildonRemoteTextureBuffer HildonRemoteTextureBuffer;
+
+#define                                         HILDON_REMOTE_TEXTURE_MAX_BUFFERS 3
+
 #define                                         HILDON_REMOTE_TEXTURE_GET_PRIVATE(obj) \
                                                 (G_TYPE_INSTANCE_GET_PRIVATE ((obj), \
                                                 HILDON_TYPE_REMOTE_TEXTURE, HildonRemoteTexturePrivate));
 
+struct                                          _HildonRemoteTextureBuffer
+{
+    key_t   key;
+    int     shmid;
+    guchar *data;
+};
+
 struct                                          _HildonRemoteTexturePrivate
 {
     guint   ready : 1;
@@ -54,10 +65,11 @@ struct                                          _HildonRemoteTexturePrivate
     guint   shm_height;
     guint   shm_bpp;
 
-    gint    damage_x1;
-    gint    damage_y1;
-    gint    damage_x2;
-    gint    damage_y2;
+    /* Damage accumulated since the last flush */
+    GdkRegion *damage;
+    guint   damage_flush_id;
+    guint   damage_submitted;
+    guint   damage_sent;
 
     guint   show;
     guint   opacity;
@@ -73,6 +85,14 @@ struct                                          _HildonRemoteTexturePrivate
     double  scale_x;
     double  scale_y;
 
+    /* Shared memory image owned by the widget, if any */
+    HildonRemoteTextureBuffer buffers[HILDON_REMOTE_TEXTURE_MAX_BUFFERS];
+    guint   n_buffers;
+    guint   back_buffer;
+    guint   image_width;
+    guint   image_height;
+    guint   image_bpp;
+
     GtkWindow* parent;
     gulong  parent_map_event_cb_id;
 
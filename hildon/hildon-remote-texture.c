@@ -32,11 +32,18 @@
  * be positioned and scaled, without altering its' contents.
  */
 
+#include                                        <sys/ipc.h>
+#include                                        <sys/shm.h>
+#include                                        <unistd.h>
+#include                                        <errno.h>
+#include                                        <string.h>
+
 #include                                        <gdk/gdkx.h>
 #include                                        <X11/Xatom.h>
 
 #include                                        "hildon-remote-texture.h"
 #include                                        "hildon-remote-texture-private.h"
+#include                                        "hildon-private.h"
 
 G_DEFINE_TYPE (HildonRemoteTexture, hildon_remote_texture, GTK_TYPE_WINDOW);
 
@@ -50,6 +57,8 @@ static void
 hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self);
 static void
 hildon_remote_texture_send_all_messages (HildonRemoteTexture *self);
+static void
+hildon_remote_texture_flush_damage (HildonRemoteTexture *self);
 static gboolean
 hildon_remote_texture_parent_map_event (GtkWidget *parent,
 					 GdkEvent *event,
@@ -70,6 +79,12 @@ static guint32 ready_atom;
 
 static gboolean atoms_initialized = FALSE;
 
+/* Damage is sent as its bounding box when the box covers at most this
+ * much more than the damaged rectangles (in 1/100ths), or when the
+ * damage is made of more rectangles than this. */
+#define                                         DAMAGE_MERGE_OVERHEAD 25
+#define                                         DAMAGE_MAX_RECTANGLES 8
+
 static void
 hildon_remote_texture_realize                 (GtkWidget *widget)
 {
@@ -82,53 +97,27 @@ hildon_remote_texture_realize                 (GtkWidget *widget)
 
     display = gdk_drawable_get_display (widget->window);
 
-    wm_type = gdk_x11_get_xatom_by_name_for_display (display, "_NET_WM_WINDOW_TYPE");
-    applet_type = gdk_x11_get_xatom_by_name_for_display (display, "_HILDON_WM_WINDOW_TYPE_REMOTE_TEXTURE");
+    wm_type = hildon_private_get_xatom (display, HILDON_ATOM_NET_WM_WINDOW_TYPE);
+    applet_type = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_WM_WINDOW_TYPE_REMOTE_TEXTURE);
 
     XChangeProperty (GDK_DISPLAY_XDISPLAY (display), GDK_WINDOW_XID (widget->window), wm_type,
                      XA_ATOM, 32, PropModeReplace,
                      (unsigned char *) &applet_type, 1);
 
-    /* This is a bit of a hack, but for the sake of speed (it is assumed that
-     * once HildonRemoteTexture is created, a lot of ClientMessages will
-     * follow), we cache all ClientMessages atoms in static variables. */
+    /* Sending a lot of ClientMessages is expected once a HildonRemoteTexture is
+     * created, so the message atoms are kept in static variables. They all
+     * come from the hildon atom table, which interns them in one request. */
 
     if (!atoms_initialized)
     {
-        shm_atom =
-            gdk_x11_get_xatom_by_name_for_display
-            (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_SHM");
-        damage_atom =
-            gdk_x11_get_xatom_by_name_for_display
-            (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_DAMAGE");
-	show_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_SHOW");
-	position_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_POSITION");
-	offset_atom =
-            gdk_x11_get_xatom_by_name_for_display
-            (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_OFFSET");
-	scale_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_SCALE");
-	parent_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_TEXTURE_CLIENT_MESSAGE_PARENT");
-	ready_atom =
-	    gdk_x11_get_xatom_by_name_for_display
-	    (display, "_HILDON_TEXTURE_CLIENT_READY");
-#if 0
-	g_debug ("shm atom = %lu\n", shm_atom);
-	g_debug ("damage atom = %lu\n", damage_atom);
-	g_debug ("show atom = %lu\n", show_atom);
-	g_debug ("position atom = %lu\n", position_atom);
-	g_debug ("offset atom = %lu\n", offset_atom);
-	g_debug ("scale atom = %lu\n", scale_atom);
-	g_debug ("parent atom = %lu\n", parent_atom);
-	g_debug ("ready atom = %lu\n", ready_atom);
-#endif
+	shm_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SHM);
+	damage_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_DAMAGE);
+	show_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SHOW);
+	position_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_POSITION);
+	offset_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_OFFSET);
+	scale_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_SCALE);
+	parent_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_MESSAGE_PARENT);
+	ready_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_TEXTURE_CLIENT_READY);
 
 	atoms_initialized = TRUE;
     }
@@ -183,6 +172,15 @@ hildon_remote_texture_finalize                (GObject *object)
 
         g_object_unref (priv->parent);
     }
+
+    hildon_remote_texture_free_image (self);
+
+    if (priv->damage_flush_id)
+        g_source_remove (priv->damage_flush_id);
+
+    gdk_region_destroy (priv->damage);
+
+    G_OBJECT_CLASS (hildon_remote_texture_parent_class)->finalize (object);
 }
 
 static void
@@ -206,12 +204,21 @@ hildon_remote_texture_init                    (HildonRemoteTexture *self)
 {
     HildonRemoteTexturePrivate
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+    guint i;
 
     /* Default non-zero values for the private variables */
 
     priv->scale_x = 1;
     priv->scale_y = 1;
     priv->opacity = 0xff;
+
+    priv->damage = gdk_region_new ();
+
+    for (i = 0; i < HILDON_REMOTE_TEXTURE_MAX_BUFFERS; i++)
+    {
+        priv->buffers[i].key = IPC_PRIVATE;
+        priv->buffers[i].shmid = -1;
+    }
 }
 
 /**
@@ -351,11 +358,7 @@ hildon_remote_texture_send_pending_messages (HildonRemoteTexture *self)
                                       priv->shm_bpp);
 
     if (priv->set_damage)
-      hildon_remote_texture_update_area (self,
-                                         priv->damage_x1,
-                                         priv->damage_y1,
-                                         priv->damage_x2 - priv->damage_x1,
-                                         priv->damage_y2 - priv->damage_y1);
+      hildon_remote_texture_flush_damage (self);
 
     if (priv->set_position)
 	hildon_remote_texture_set_position (self,
@@ -390,12 +393,20 @@ hildon_remote_texture_send_all_messages (HildonRemoteTexture *self)
 	               *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
 
     priv->set_shm = 1;
-    priv->set_damage = 1;
     priv->set_position = 1;
     priv->set_scale = 1;
     priv->set_parent = 1;
     priv->set_show = 1;
 
+    /* The new window manager has none of the image yet */
+    if (priv->shm_width && priv->shm_height)
+    {
+        GdkRectangle all = { 0, 0, priv->shm_width, priv->shm_height };
+
+        gdk_region_union_with_rect (priv->damage, &all);
+        priv->set_damage = 1;
+    }
+
     hildon_remote_texture_send_pending_messages (self);
 }
 
@@ -503,6 +514,348 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
     }
 }
 
+/*
+ * Creates a new shared memory segment of @size bytes under a key
+ * that is not in use yet, and attaches it to our address space.
+ */
+static gboolean
+hildon_remote_texture_create_buffer (HildonRemoteTextureBuffer *buffer,
+                                     gsize size)
+{
+  static guint serial = 0;
+  gint attempt;
+
+  buffer->shmid = -1;
+
+  for (attempt = 0; attempt < 64; attempt++)
+    {
+      buffer->key = (key_t) (((getpid () & 0x7ffff) << 12) | (serial++ & 0xfff));
+      if (buffer->key == IPC_PRIVATE)
+        continue;
+
+      /* Only the compositor, running as the same user, maps the segment */
+      buffer->shmid = shmget (buffer->key, size, IPC_CREAT | IPC_EXCL | 0600);
+      if (buffer->shmid >= 0 || errno != EEXIST)
+        break;
+    }
+
+  if (buffer->shmid < 0)
+    {
+      g_warning ("Unable to create shared memory for remote texture: %s",
+                 g_strerror (errno));
+      return FALSE;
+    }
+
+  buffer->data = shmat (buffer->shmid, NULL, 0);
+  if (buffer->data == (guchar *) -1)
+    {
+      g_warning ("Unable to attach shared memory for remote texture: %s",
+                 g_strerror (errno));
+      shmctl (buffer->shmid, IPC_RMID, NULL);
+      buffer->shmid = -1;
+      buffer->data = NULL;
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+hildon_remote_texture_destroy_buffer (HildonRemoteTextureBuffer *buffer)
+{
+  if (buffer->data)
+    shmdt (buffer->data);
+
+  if (buffer->shmid >= 0)
+    shmctl (buffer->shmid, IPC_RMID, NULL);
+
+  buffer->key = IPC_PRIVATE;
+  buffer->shmid = -1;
+  buffer->data = NULL;
+}
+
+/**
+ * hildon_remote_texture_alloc_image:
+ * @self: A #HildonRemoteTexture
+ * @width: width of image in pixels
+ * @height: height of image in pixels
+ * @bpp: BYTES per pixel - usually 2,3 or 4
+ * @n_buffers: number of image buffers, from 1 to 3
+ *
+ * Creates the shared memory image displayed by @self and hands it over
+ * to hildon-desktop, replacing any image previously set with
+ * hildon_remote_texture_set_image(). The memory is owned by @self and is
+ * released with hildon_remote_texture_free_image() or when @self is
+ * destroyed.
+ *
+ * With a single buffer, the application draws directly into the image
+ * shown by hildon-desktop. With two or three buffers, it draws into a back
+ * buffer that is only shown after hildon_remote_texture_swap_image(); the
+ * back buffer then holds the frame drawn @n_buffers swaps earlier.
+ *
+ * Returns: %TRUE if the image was allocated, %FALSE otherwise.
+ *
+ * Since: 2.2.25
+ **/
+gboolean
+hildon_remote_texture_alloc_image (HildonRemoteTexture *self,
+                                   guint width,
+                                   guint height,
+                                   guint bpp,
+                                   guint n_buffers)
+{
+  HildonRemoteTexturePrivate *priv;
+  gsize size;
+  guint i;
+
+  g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), FALSE);
+  g_return_val_if_fail (width > 0 && height > 0 && bpp > 0, FALSE);
+  g_return_val_if_fail (n_buffers >= 1 &&
+                        n_buffers <= HILDON_REMOTE_TEXTURE_MAX_BUFFERS, FALSE);
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  hildon_remote_texture_free_image (self);
+
+  size = (gsize) width * height * bpp;
+
+  for (i = 0; i < n_buffers; i++)
+    {
+      if (!hildon_remote_texture_create_buffer (&priv->buffers[i], size))
+        {
+          priv->n_buffers = i;
+          hildon_remote_texture_free_image (self);
+          return FALSE;
+        }
+    }
+
+  priv->n_buffers = n_buffers;
+  priv->back_buffer = n_buffers > 1 ? 1 : 0;
+  priv->image_width = width;
+  priv->image_height = height;
+  priv->image_bpp = bpp;
+
+  hildon_remote_texture_set_image (self, priv->buffers[0].key,
+                                   width, height, bpp);
+
+  return TRUE;
+}
+
+/**
+ * hildon_remote_texture_resize_image:
+ * @self: A #HildonRemoteTexture
+ * @width: new width of image in pixels
+ * @height: new height of image in pixels
+ * @bpp: new BYTES per pixel
+ *
+ * Reallocates the image created with hildon_remote_texture_alloc_image()
+ * with a new size, keeping the number of buffers. The contents of the
+ * image are lost and pointers returned by
+ * hildon_remote_texture_get_image_data() become invalid.
+ *
+ * Returns: %TRUE if the image was reallocated, %FALSE otherwise.
+ *
+ * Since: 2.2.25
+ **/
+gboolean
+hildon_remote_texture_resize_image (HildonRemoteTexture *self,
+                                    guint width,
+                                    guint height,
+                                    guint bpp)
+{
+  HildonRemoteTexturePrivate *priv;
+
+  g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), FALSE);
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  g_return_val_if_fail (priv->n_buffers > 0, FALSE);
+
+  if (width == priv->image_width && height == priv->image_height &&
+      bpp == priv->image_bpp)
+    return TRUE;
+
+  return hildon_remote_texture_alloc_image (self, width, height, bpp,
+                                            priv->n_buffers);
+}
+
+/**
+ * hildon_remote_texture_get_image_data:
+ * @self: A #HildonRemoteTexture
+ *
+ * Gets the memory the application should draw the next frame into. Rows
+ * are stored one after the other, each being width * bpp bytes long.
+ *
+ * Returns: a pointer to the current back buffer of the image allocated
+ * with hildon_remote_texture_alloc_image(), or %NULL if there is none.
+ *
+ * Since: 2.2.25
+ **/
+guchar *
+hildon_remote_texture_get_image_data (HildonRemoteTexture *self)
+{
+  HildonRemoteTexturePrivate *priv;
+
+  g_return_val_if_fail (HILDON_IS_REMOTE_TEXTURE (self), NULL);
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  if (priv->n_buffers == 0)
+    return NULL;
+
+  return priv->buffers[priv->back_buffer].data;
+}
+
+/**
+ * hildon_remote_texture_swap_image:
+ * @self: A #HildonRemoteTexture
+ * @damage: the area of the back buffer that was drawn, or %NULL if
+ * the whole frame changed
+ *
+ * Shows the frame drawn into the buffer returned by
+ * hildon_remote_texture_get_image_data(), and damages @damage with
+ * hildon_remote_texture_update_area(). With more than one buffer, the
+ * next buffer in turn becomes the back buffer.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_remote_texture_swap_image (HildonRemoteTexture *self,
+                                  const GdkRectangle *damage)
+{
+  HildonRemoteTexturePrivate *priv;
+
+  g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  g_return_if_fail (priv->n_buffers > 0);
+
+  if (priv->n_buffers > 1)
+    {
+      /* Damage of earlier frames refers to the buffer shown now */
+      hildon_remote_texture_commit_damage (self);
+
+      hildon_remote_texture_set_image (self,
+                                       priv->buffers[priv->back_buffer].key,
+                                       priv->image_width,
+                                       priv->image_height,
+                                       priv->image_bpp);
+      priv->back_buffer = (priv->back_buffer + 1) % priv->n_buffers;
+    }
+
+  if (damage)
+    hildon_remote_texture_update_area (self, damage->x, damage->y,
+                                       damage->width, damage->height);
+  else
+    hildon_remote_texture_update_area (self, 0, 0,
+                                       priv->image_width,
+                                       priv->image_height);
+}
+
+/**
+ * hildon_remote_texture_free_image:
+ * @self: A #HildonRemoteTexture
+ *
+ * Releases the shared memory image created with
+ * hildon_remote_texture_alloc_image(), if any.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_remote_texture_free_image (HildonRemoteTexture *self)
+{
+  HildonRemoteTexturePrivate *priv;
+  guint i;
+
+  g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  for (i = 0; i < priv->n_buffers; i++)
+    hildon_remote_texture_destroy_buffer (&priv->buffers[i]);
+
+  priv->n_buffers = 0;
+  priv->back_buffer = 0;
+  priv->image_width = 0;
+  priv->image_height = 0;
+  priv->image_bpp = 0;
+}
+
+/*
+ * Sends the accumulated damage to the window manager, either as its
+ * bounding box or as separate rectangles when merging them would make
+ * hildon-desktop update much more of the texture than needed.
+ */
+static void
+hildon_remote_texture_flush_damage (HildonRemoteTexture *self)
+{
+  HildonRemoteTexturePrivate
+                     *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+  GtkWidget          *widget = GTK_WIDGET (self);
+  GdkRectangle        box;
+  GdkRectangle       *rects;
+  gint                n_rects, i;
+  gint64              area = 0;
+
+  if (!priv->set_damage)
+    return;
+
+  if (!GTK_WIDGET_MAPPED (widget) || !priv->ready)
+    return;
+
+  /* Defer messages until the remote texture is parented
+   * and the parent window is mapped */
+  if (!priv->parent || !GTK_WIDGET_MAPPED (GTK_WIDGET (priv->parent)))
+    return;
+
+  gdk_region_get_clipbox (priv->damage, &box);
+  gdk_region_get_rectangles (priv->damage, &rects, &n_rects);
+
+  for (i = 0; i < n_rects; i++)
+    area += (gint64) rects[i].width * rects[i].height;
+
+  if (n_rects <= 1 || n_rects > DAMAGE_MAX_RECTANGLES ||
+      ((gint64) box.width * box.height - area) * 100 <=
+      (gint64) box.width * box.height * DAMAGE_MERGE_OVERHEAD)
+    {
+      g_free (rects);
+      rects = g_memdup (&box, sizeof (GdkRectangle));
+      n_rects = 1;
+    }
+
+  for (i = 0; i < n_rects; i++)
+    {
+      hildon_remote_texture_send_message (self,
+                                          damage_atom,
+                                          rects[i].x,
+                                          rects[i].y,
+                                          rects[i].width,
+                                          rects[i].height,
+                                          0);
+      priv->damage_sent++;
+    }
+
+  g_free (rects);
+
+  gdk_region_destroy (priv->damage);
+  priv->damage = gdk_region_new ();
+  priv->set_damage = 0;
+}
+
+static gboolean
+hildon_remote_texture_flush_damage_idle (gpointer data)
+{
+  HildonRemoteTexture *self = HILDON_REMOTE_TEXTURE (data);
+  HildonRemoteTexturePrivate
+                     *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  priv->damage_flush_id = 0;
+  hildon_remote_texture_flush_damage (self);
+
+  return FALSE;
+}
+
 /**
  * hildon_remote_texture_update_area:
  * @self: A #HildonRemoteTexture
@@ -515,6 +868,11 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
  * has changed. This will trigger a redraw and will update the relevant tiles
  * of the texture.
  *
+ * Areas damaged during one main loop iteration are accumulated and sent
+ * together once the iteration is over, merged into fewer rectangles where
+ * that does not make hildon-desktop update much more than was damaged.
+ * Use hildon_remote_texture_commit_damage() to send them right away.
+ *
  * Since: 2.2
  */
 void
@@ -526,43 +884,81 @@ hildon_remote_texture_update_area (HildonRemoteTexture *self,
 {
   HildonRemoteTexturePrivate
                      *priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
-  GtkWidget          *widget = GTK_WIDGET (self);
+  GdkRectangle        rect = { x, y, width, height };
 
-  if (priv->damage_x1==priv->damage_x2 || priv->damage_y1==priv->damage_y2)
-    {
-      priv->damage_x1 = x;
-      priv->damage_y1 = y;
-      priv->damage_x2 = x+width;
-      priv->damage_y2 = y+height;
-    }
-  else
+  if (width <= 0 || height <= 0)
+    return;
+
+  gdk_region_union_with_rect (priv->damage, &rect);
+  priv->damage_submitted++;
+  priv->set_damage = 1;
+
+  if (!priv->damage_flush_id)
+    priv->damage_flush_id =
+      gdk_threads_add_idle_full (GDK_PRIORITY_REDRAW,
+                                 hildon_remote_texture_flush_damage_idle,
+                                 self, NULL);
+}
+
+/**
+ * hildon_remote_texture_commit_damage:
+ * @self: A #HildonRemoteTexture
+ *
+ * Sends the areas passed to hildon_remote_texture_update_area() since
+ * the last commit to hildon-desktop without waiting for the end of the
+ * current main loop iteration. If the remote texture WM-counterpart is
+ * not ready, the damage stays queued until it is.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_remote_texture_commit_damage (HildonRemoteTexture *self)
+{
+  HildonRemoteTexturePrivate *priv;
+
+  g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  if (priv->damage_flush_id)
     {
-      if (x<priv->damage_x1) priv->damage_x1 = x;
-      if (y<priv->damage_y1) priv->damage_y1 = y;
-      if (x+width>priv->damage_x2) priv->damage_x2 = x+width;
-      if (y+height>priv->damage_y2) priv->damage_y2 = y+height;
+      g_source_remove (priv->damage_flush_id);
+      priv->damage_flush_id = 0;
     }
-  priv->set_damage = 1;
 
-  if (GTK_WIDGET_MAPPED (widget) && priv->ready)
-  {
-     /* Defer messages until the remote texture is parented
-      * and the parent window is mapped */
-      if (!priv->parent || !GTK_WIDGET_MAPPED (GTK_WIDGET (priv->parent)))
-          return;
-      hildon_remote_texture_send_message (self,
-                                          damage_atom,
-                                          priv->damage_x1,
-                                          priv->damage_y1,
-                                          priv->damage_x2 - priv->damage_x1,
-                                          priv->damage_y2 - priv->damage_y1,
-                                          0);
-      priv->set_damage = 0;
-      priv->damage_x1 = 0;
-      priv->damage_y1 = 0;
-      priv->damage_x2 = 0;
-      priv->damage_y2 = 0;
-  }
+  hildon_remote_texture_flush_damage (self);
+}
+
+/**
+ * hildon_remote_texture_get_damage_stats:
+ * @self: A #HildonRemoteTexture
+ * @submitted: return location for the number of areas passed to
+ * hildon_remote_texture_update_area(), or %NULL
+ * @sent: return location for the number of damage messages sent to
+ * hildon-desktop, or %NULL
+ *
+ * Retrieves how many damaged areas were reported by the application and
+ * how many were actually sent after accumulating them. The counters
+ * accumulate over the lifetime of @self.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_remote_texture_get_damage_stats (HildonRemoteTexture *self,
+                                        guint *submitted,
+                                        guint *sent)
+{
+  HildonRemoteTexturePrivate *priv;
+
+  g_return_if_fail (HILDON_IS_REMOTE_TEXTURE (self));
+
+  priv = HILDON_REMOTE_TEXTURE_GET_PRIVATE (self);
+
+  if (submitted)
+    *submitted = priv->damage_submitted;
+
+  if (sent)
+    *sent = priv->damage_sent;
 }
 
 /**
@@ -97,6 +97,24 @@ hildon_remote_texture_set_image (HildonRemoteTexture *self,
                                  guint width,
                                  guint height,
                                  guint bpp);
+gboolean
+hildon_remote_texture_alloc_image (HildonRemoteTexture *self,
+                                   guint width,
+                                   guint height,
+                                   guint bpp,
+                                   guint n_buffers);
+gboolean
+hildon_remote_texture_resize_image (HildonRemoteTexture *self,
+                                    guint width,
+                                    guint height,
+                                    guint bpp);
+guchar *
+hildon_remote_texture_get_image_data (HildonRemoteTexture *self);
+void
+hildon_remote_texture_swap_image (HildonRemoteTexture *self,
+                                  const GdkRectangle *damage);
+void
+hildon_remote_texture_free_image (HildonRemoteTexture *self);
 void
 hildon_remote_texture_update_area (HildonRemoteTexture *self,
                                    gint x,
@@ -104,6 +122,12 @@ hildon_remote_texture_update_area (HildonRemoteTexture *self,
                                    gint width,
                                    gint height);
 void
+hildon_remote_texture_commit_damage (HildonRemoteTexture *self);
+void
+hildon_remote_texture_get_damage_stats (HildonRemoteTexture *self,
+                                        guint *submitted,
+                                        guint *sent);
+void
 hildon_remote_texture_set_show_full (HildonRemoteTexture *self,
 				      gint show,
 				      gint opacity);
@@ -0,0 +1,67 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef                                         __HILDON_SIZE_GROUP_PRIVATE_H__
+#define                                         __HILDON_SIZE_GROUP_PRIVATE_H__
+
+G_BEGIN_DECLS
+
+typedef struct                                  _HildonSizeGroupPrivate HildonSizeGroupPrivate;
+
+typedef struct                                  _HildonSizeGroupMember HildonSizeGroupMember;
+
+#define                                         HILDON_SIZE_GROUP_GET_PRIVATE(obj) \
+                                                (G_TYPE_INSTANCE_GET_PRIVATE ((obj), \
+                                                HILDON_TYPE_SIZE_GROUP, HildonSizeGroupPrivate));
+
+struct                                          _HildonSizeGroupMember
+{
+    HildonSizeGroup *group;
+    GtkWidget       *widget;
+
+    /* Natural width of the widget, as of its last size request */
+    gint             width;
+
+    /* Position of the member in HildonSizeGroupPrivate.members */
+    GSequenceIter   *iter;
+
+    gulong           size_request_id;
+    gulong           destroy_id;
+};
+
+struct                                          _HildonSizeGroupPrivate
+{
+    /* Members of the group, sorted by natural width */
+    GSequence *members;
+
+    /* Width requested by every member of the group */
+    gint       width;
+
+    /* Idle that asks the members to request the new width */
+    guint      resize_id;
+};
+
+G_END_DECLS
+
+#endif                                          /* __HILDON_SIZE_GROUP_PRIVATE_H__ */
@@ -0,0 +1,322 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+/**
+ * SECTION:hildon-size-group
+ * @short_description: Size group that caches the width of its members.
+ * @see_also: #GtkSizeGroup, #HildonButton, #HildonCaption
+ *
+ * A #HildonSizeGroup makes all its members request the same width,
+ * like a horizontal #GtkSizeGroup does. Unlike #GtkSizeGroup, it
+ * remembers the natural width of every member and keeps the members
+ * sorted by it, so when one member changes only that member is
+ * measured again, and finding the new width of the group takes
+ * logarithmic time. The other members are just allocated again if the
+ * width of the group changed.
+ *
+ * A #HildonSizeGroup can be passed to hildon_button_add_title_size_group(),
+ * hildon_button_add_value_size_group(), hildon_button_add_image_size_group()
+ * and hildon_caption_set_size_group(). Other widgets must be added with
+ * hildon_size_group_add_widget() instead of gtk_size_group_add_widget(),
+ * as widgets added with the latter are not aligned with the rest.
+ *
+ * A widget can only belong to one #HildonSizeGroup at a time, and its
+ * width must not be forced with gtk_widget_set_size_request().
+ *
+ * As members are tracked by #HildonSizeGroup itself, gtk_size_group_get_widgets()
+ * does not return them. When the width of the group changes, the other
+ * members can't be resized from within the size request that changed
+ * it, so they pick up the new width in a second layout pass, run right
+ * after the first one.
+ *
+ * <example>
+ * <title>Aligning the titles of several buttons</title>
+ * <programlisting>
+ * GtkSizeGroup *group = hildon_size_group_new ();
+ * <!-- -->
+ * for (i = 0; i < n_buttons; i++)
+ *     hildon_button_add_title_size_group (HILDON_BUTTON (buttons[i]), group);
+ * <!-- -->
+ * g_object_unref (group);
+ * </programlisting>
+ * </example>
+ */
+
+#include                                        "hildon-size-group.h"
+#include                                        "hildon-size-group-private.h"
+
+G_DEFINE_TYPE (HildonSizeGroup, hildon_size_group, GTK_TYPE_SIZE_GROUP);
+
+static GQuark                                   member_quark = 0;
+
+static gint
+hildon_size_group_compare_members               (gconstpointer a,
+                                                 gconstpointer b,
+                                                 gpointer data)
+{
+    return ((const HildonSizeGroupMember *) a)->width -
+        ((const HildonSizeGroupMember *) b)->width;
+}
+
+static gint
+hildon_size_group_compute_width                 (HildonSizeGroupPrivate *priv)
+{
+    GSequenceIter *iter = g_sequence_get_end_iter (priv->members);
+    HildonSizeGroupMember *widest;
+
+    if (g_sequence_iter_is_begin (iter))
+        return 0;
+
+    widest = g_sequence_get (g_sequence_iter_prev (iter));
+
+    return widest->width;
+}
+
+/* Queues a resize of every member that does not request the width of
+ * the group yet. Members are not measured again from scratch: only the
+ * members themselves are flagged, so their children return their cached
+ * requisitions. */
+static gboolean
+hildon_size_group_resize_members                (gpointer data)
+{
+    HildonSizeGroupPrivate *priv = HILDON_SIZE_GROUP_GET_PRIVATE (data);
+    GSequenceIter *iter;
+
+    priv->resize_id = 0;
+
+    iter = g_sequence_get_begin_iter (priv->members);
+    while (!g_sequence_iter_is_end (iter)) {
+        HildonSizeGroupMember *member = g_sequence_get (iter);
+
+        if (member->widget->requisition.width != priv->width)
+            gtk_widget_queue_resize (member->widget);
+
+        iter = g_sequence_iter_next (iter);
+    }
+
+    return FALSE;
+}
+
+/* Updates the width of the group. The other members can't be resized
+ * from within a size request, so that is left to an idle handler that
+ * runs before GTK+ lays out the windows again. */
+static void
+hildon_size_group_update                        (HildonSizeGroup *group)
+{
+    HildonSizeGroupPrivate *priv = HILDON_SIZE_GROUP_GET_PRIVATE (group);
+    gint width;
+
+    width = hildon_size_group_compute_width (priv);
+    if (width == priv->width)
+        return;
+
+    priv->width = width;
+
+    if (priv->resize_id == 0)
+        priv->resize_id = gdk_threads_add_idle_full (GTK_PRIORITY_RESIZE - 1,
+                                                     hildon_size_group_resize_members,
+                                                     group, NULL);
+}
+
+static void
+hildon_size_group_member_size_request           (GtkWidget *widget,
+                                                 GtkRequisition *requisition,
+                                                 HildonSizeGroupMember *member)
+{
+    HildonSizeGroupPrivate *priv = HILDON_SIZE_GROUP_GET_PRIVATE (member->group);
+
+    /* The class handler has just stored the natural size */
+    if (requisition->width != member->width) {
+        member->width = requisition->width;
+        g_sequence_sort_changed (member->iter, hildon_size_group_compare_members, NULL);
+        hildon_size_group_update (member->group);
+    }
+
+    requisition->width = priv->width;
+}
+
+static void
+hildon_size_group_member_destroy                (GtkWidget *widget,
+                                                 HildonSizeGroup *group)
+{
+    hildon_size_group_remove_widget (group, widget);
+}
+
+static void
+hildon_size_group_finalize                      (GObject *object)
+{
+    HildonSizeGroupPrivate *priv = HILDON_SIZE_GROUP_GET_PRIVATE (object);
+
+    /* Members keep a reference on the group, so it is empty by now */
+    g_sequence_free (priv->members);
+
+    if (priv->resize_id)
+        g_source_remove (priv->resize_id);
+
+    G_OBJECT_CLASS (hildon_size_group_parent_class)->finalize (object);
+}
+
+static void
+hildon_size_group_class_init                    (HildonSizeGroupClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+    gobject_class->finalize = hildon_size_group_finalize;
+
+    member_quark = g_quark_from_static_string ("hildon-size-group-member");
+
+    g_type_class_add_private (klass, sizeof (HildonSizeGroupPrivate));
+}
+
+static void
+hildon_size_group_init                          (HildonSizeGroup *self)
+{
+    HildonSizeGroupPrivate *priv = HILDON_SIZE_GROUP_GET_PRIVATE (self);
+
+    priv->members = g_sequence_new (NULL);
+    priv->width = 0;
+    priv->resize_id = 0;
+}
+
+/**
+ * hildon_size_group_new:
+ *
+ * Creates a new #HildonSizeGroup.
+ *
+ * Returns: a new #HildonSizeGroup, as a #GtkSizeGroup
+ *
+ * Since: 2.2.25
+ **/
+GtkSizeGroup*
+hildon_size_group_new                           (void)
+{
+    return g_object_new (HILDON_TYPE_SIZE_GROUP,
+                         "mode", GTK_SIZE_GROUP_HORIZONTAL, NULL);
+}
+
+/**
+ * hildon_size_group_add_widget:
+ * @group: a #HildonSizeGroup
+ * @widget: the #GtkWidget to add
+ *
+ * Adds @widget to @group. From then on @widget requests the width of
+ * the widest member of @group. If @widget was in another
+ * #HildonSizeGroup, it is removed from it first.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_size_group_add_widget                    (HildonSizeGroup *group,
+                                                 GtkWidget *widget)
+{
+    HildonSizeGroupPrivate *priv;
+    HildonSizeGroupMember *member;
+
+    g_return_if_fail (HILDON_IS_SIZE_GROUP (group));
+    g_return_if_fail (GTK_IS_WIDGET (widget));
+
+    member = g_object_get_qdata (G_OBJECT (widget), member_quark);
+    if (member != NULL) {
+        if (member->group == group)
+            return;
+        hildon_size_group_remove_widget (member->group, widget);
+    }
+
+    priv = HILDON_SIZE_GROUP_GET_PRIVATE (group);
+
+    member = g_slice_new0 (HildonSizeGroupMember);
+    member->group = g_object_ref (group);
+    member->widget = widget;
+    member->width = 0;
+    member->iter = g_sequence_insert_sorted (priv->members, member,
+                                             hildon_size_group_compare_members, NULL);
+    member->size_request_id = g_signal_connect_after (widget, "size-request",
+                                                      G_CALLBACK (hildon_size_group_member_size_request),
+                                                      member);
+    member->destroy_id = g_signal_connect (widget, "destroy",
+                                           G_CALLBACK (hildon_size_group_member_destroy), group);
+
+    g_object_set_qdata (G_OBJECT (widget), member_quark, member);
+
+    /* Measure the new member once */
+    gtk_widget_queue_resize (widget);
+}
+
+/**
+ * hildon_size_group_remove_widget:
+ * @group: a #HildonSizeGroup
+ * @widget: a #GtkWidget in @group
+ *
+ * Removes @widget from @group. @widget requests its natural width
+ * again.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_size_group_remove_widget                 (HildonSizeGroup *group,
+                                                 GtkWidget *widget)
+{
+    HildonSizeGroupMember *member;
+
+    g_return_if_fail (HILDON_IS_SIZE_GROUP (group));
+    g_return_if_fail (GTK_IS_WIDGET (widget));
+
+    member = g_object_get_qdata (G_OBJECT (widget), member_quark);
+    g_return_if_fail (member != NULL && member->group == group);
+
+    g_signal_handler_disconnect (widget, member->size_request_id);
+    g_signal_handler_disconnect (widget, member->destroy_id);
+    g_sequence_remove (member->iter);
+    g_object_set_qdata (G_OBJECT (widget), member_quark, NULL);
+    g_slice_free (HildonSizeGroupMember, member);
+
+    hildon_size_group_update (group);
+    gtk_widget_queue_resize (widget);
+
+    g_object_unref (group);
+}
+
+/**
+ * hildon_size_group_get_width:
+ * @group: a #HildonSizeGroup
+ *
+ * Gets the width currently requested by the members of @group, which
+ * is the natural width of its widest member as of the last time the
+ * members were measured.
+ *
+ * Returns: the width of @group, or 0 if it has no members
+ *
+ * Since: 2.2.25
+ **/
+gint
+hildon_size_group_get_width                     (HildonSizeGroup *group)
+{
+    HildonSizeGroupPrivate *priv;
+
+    g_return_val_if_fail (HILDON_IS_SIZE_GROUP (group), 0);
+
+    priv = HILDON_SIZE_GROUP_GET_PRIVATE (group);
+
+    return priv->width;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is a part of hildon
+ *
+ * Copyright (C) 2008 Nokia Corporation, all rights reserved.
+ *
+ * Contact: Rodrigo Novo <rodrigo.novo@nokia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#ifndef                                         __HILDON_SIZE_GROUP_H__
+#define                                         __HILDON_SIZE_GROUP_H__
+
+#include                                        <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define                                         HILDON_TYPE_SIZE_GROUP \
+                                                (hildon_size_group_get_type())
+
+#define                                         HILDON_SIZE_GROUP(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_CAST ((obj), \
+                                                HILDON_TYPE_SIZE_GROUP, \
+                                                HildonSizeGroup))
+
+#define                                         HILDON_SIZE_GROUP_CLASS(klass) \
+                                                (G_TYPE_CHECK_CLASS_CAST ((klass), \
+                                                HILDON_TYPE_SIZE_GROUP, \
+                                                HildonSizeGroupClass))
+
+#define                                         HILDON_IS_SIZE_GROUP(obj) \
+                                                (G_TYPE_CHECK_INSTANCE_TYPE ((obj), \
+                                                HILDON_TYPE_SIZE_GROUP))
+
+#define                                         HILDON_IS_SIZE_GROUP_CLASS(klass) \
+                                                (G_TYPE_CHECK_CLASS_TYPE ((klass), \
+                                                HILDON_TYPE_SIZE_GROUP))
+
+#define                                         HILDON_SIZE_GROUP_GET_CLASS(obj) \
+                                                (G_TYPE_INSTANCE_GET_CLASS ((obj), \
+                                                HILDON_TYPE_SIZE_GROUP, \
+                                                HildonSizeGroupClass))
+
+typedef struct                                  _HildonSizeGroup HildonSizeGroup;
+typedef struct                                  _HildonSizeGroupClass HildonSizeGroupClass;
+
+struct                                          _HildonSizeGroupClass
+{
+    GtkSizeGroupClass parent_class;
+};
+
+struct                                          _HildonSizeGroup
+{
+    GtkSizeGroup parent;
+};
+
+GType
+hildon_size_group_get_type                      (void) G_GNUC_CONST;
+
+GtkSizeGroup*
+hildon_size_group_new                           (void);
+
+void
+hildon_size_group_add_widget                    (HildonSizeGroup *group,
+                                                 GtkWidget *widget);
+
+void
+hildon_size_group_remove_widget                 (HildonSizeGroup *group,
+                                                 GtkWidget *widget);
+
+gint
+hildon_size_group_get_width                     (HildonSizeGroup *group);
+
+G_END_DECLS
+
+#endif                                          /* __HILDON_SIZE_GROUP_H__ */
@@ -28,6 +28,10 @@
  *
  * Please note that this method is only provided for backwards compatibility,
  * but we highly recommend you to use canberra-gtk directly instead.
+ *
+ * Samples that are played often can be uploaded to the sound server
+ * beforehand with hildon_sound_cache_sample(), so that playing them does
+ * not require opening and decoding the file again.
  * 
  */
 
@@ -39,6 +43,13 @@
 
 #define ALARM_GCONF_PATH "/apps/osso/sound/system_alert_volume"
 
+/* Properties of the samples uploaded with hildon_sound_cache_sample(),
+ * by file name. Other samples are not remembered, so the table only
+ * grows with the files the application chooses to cache. */
+static GHashTable *samples = NULL;
+
+G_LOCK_DEFINE_STATIC (samples);
+
 static ca_context *hildon_ca_context_get (void);
 
 /*
@@ -79,6 +90,138 @@ hildon_ca_context_get (void)
     return c;
 }
 
+/*
+ * hildon_sound_new_proplist:
+ *
+ * Builds the properties used to play @filename. The event id names
+ * the sample in the cache of the sound server, which is shared by all
+ * its clients, so it is derived from the absolute path of the file:
+ * every application gets the same id for the same file, and different
+ * ids for different files.
+ */
+static ca_proplist *
+hildon_sound_new_proplist (const gchar *filename)
+{
+    ca_proplist *proplist;
+    gchar *path, *checksum, *event_id;
+
+    if (g_path_is_absolute (filename)) {
+        path = g_strdup (filename);
+    } else {
+        gchar *cwd = g_get_current_dir ();
+        path = g_build_filename (cwd, filename, NULL);
+        g_free (cwd);
+    }
+
+    checksum = g_compute_checksum_for_string (G_CHECKSUM_MD5, path, -1);
+    event_id = g_strconcat ("x-hildon-sound-", checksum, NULL);
+
+    ca_proplist_create(&proplist);
+    ca_proplist_sets(proplist, CA_PROP_EVENT_ID, event_id);
+    ca_proplist_sets(proplist, CA_PROP_MEDIA_FILENAME, path);
+    ca_proplist_sets(proplist, CA_PROP_MEDIA_ROLE, "dialog-information");
+    ca_proplist_sets(proplist, "module-stream-restore.id", "x-maemo-system-sound");
+
+    g_free (event_id);
+    g_free (checksum);
+    g_free (path);
+
+    return proplist;
+}
+
+/**
+ * hildon_sound_cache_sample:
+ * @sample: sound file to cache
+ *
+ * Uploads @sample to the cache of the sound server, so that later calls
+ * to hildon_sound_play_sample() or hildon_play_system_sound() for the
+ * same file do not need to read and decode it. This is best done once,
+ * when the application starts.
+ *
+ * Returns: %TRUE if @sample is in the cache, %FALSE if it could not be
+ * cached, for example because the sound backend has no cache.
+ *
+ * Since: 2.2.25
+ */
+gboolean
+hildon_sound_cache_sample (const gchar *sample)
+{
+    ca_context *ca_con = NULL;
+    ca_proplist *pl;
+    gboolean cached;
+
+    g_return_val_if_fail (sample != NULL, FALSE);
+
+    ca_con = hildon_ca_context_get ();
+    if (ca_con == NULL)
+        return FALSE;
+
+    G_LOCK (samples);
+
+    if (samples == NULL)
+        samples = g_hash_table_new (g_str_hash, g_str_equal);
+
+    cached = g_hash_table_lookup (samples, sample) != NULL;
+    if (!cached) {
+        pl = hildon_sound_new_proplist (sample);
+        cached = ca_context_cache_full(ca_con, pl) == CA_SUCCESS;
+        if (cached)
+            g_hash_table_insert (samples, g_strdup (sample), pl);
+        else
+            ca_proplist_destroy (pl);
+    }
+
+    G_UNLOCK (samples);
+
+    return cached;
+}
+
+/**
+ * hildon_sound_play_sample:
+ * @sample: sound file to play
+ *
+ * Plays @sample like hildon_play_system_sound() does. If @sample was
+ * cached with hildon_sound_cache_sample(), it is played from the cache
+ * of the sound server.
+ *
+ * Returns: %TRUE if @sample was played from the cache, %FALSE if it was
+ * read from disk or could not be played.
+ *
+ * Since: 2.2.25
+ */
+gboolean
+hildon_sound_play_sample (const gchar *sample)
+{
+    ca_context *ca_con = NULL;
+    ca_proplist *pl = NULL;
+    gboolean cached;
+    int ret;
+
+    g_return_val_if_fail (sample != NULL, FALSE);
+
+    ca_con = hildon_ca_context_get ();
+    if (ca_con == NULL)
+        return FALSE;
+
+    /* Cached samples are never freed, so their proplist can be used
+     * unlocked */
+    G_LOCK (samples);
+    if (samples != NULL)
+        pl = g_hash_table_lookup (samples, sample);
+    G_UNLOCK (samples);
+
+    cached = pl != NULL;
+    if (!cached)
+        pl = hildon_sound_new_proplist (sample);
+
+    ret = ca_context_play_full(ca_con, 0, pl, NULL, NULL);
+
+    if (!cached)
+        ca_proplist_destroy (pl);
+
+    return cached && ret == CA_SUCCESS;
+}
+
 /**
  * hildon_play_system_sound:
  * @sample: sound file to play
@@ -89,22 +232,12 @@ hildon_ca_context_get (void)
  * This method sets the "dialog-information" role for the sound played,
  * so you need to keep this into account when using it. For any purpose, it
  * is highly recommended that you use canberra-gtk instead of this method.
+ *
+ * See hildon_sound_play_sample() to know whether the sample was played
+ * from the cache.
  */
 void 
 hildon_play_system_sound(const gchar *sample)
 {
-    int ret;
-    ca_context *ca_con = NULL;
-    ca_proplist *pl = NULL;
-
-    ca_con = hildon_ca_context_get ();
-
-    ca_proplist_create(&pl);
-    ca_proplist_sets(pl, CA_PROP_MEDIA_FILENAME, sample);
-    ca_proplist_sets(pl, CA_PROP_MEDIA_ROLE, "dialog-information");
-    ca_proplist_sets(pl, "module-stream-restore.id", "x-maemo-system-sound");
-
-    ret = ca_context_play_full(ca_con, 0, pl, NULL, NULL);
-
-    ca_proplist_destroy(pl);
+    hildon_sound_play_sample (sample);
 }
@@ -32,6 +32,12 @@ G_BEGIN_DECLS
 void 
 hildon_play_system_sound                        (const gchar *sample);
 
+gboolean
+hildon_sound_cache_sample                       (const gchar *sample);
+
+gboolean
+hildon_sound_play_sample                        (const gchar *sample);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_SOUND_H__ */
@@ -33,6 +33,7 @@ struct                                          _HildonStackableWindowPrivate
 {
     HildonWindowStack *stack;
     gint stack_position;
+    GList *stack_link; /* link of the window in the list of its stack */
 };
 
 #define                                         HILDON_STACKABLE_WINDOW_GET_PRIVATE(obj) \
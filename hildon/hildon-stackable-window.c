@@ -104,6 +104,7 @@
 #include                                        "hildon-stackable-window-private.h"
 #include                                        "hildon-window-stack.h"
 #include                                        "hildon-window-stack-private.h"
+#include                                        "hildon-private.h"
 
 G_DEFINE_TYPE (HildonStackableWindow, hildon_stackable_window, HILDON_TYPE_WINDOW);
 
@@ -176,7 +177,7 @@ hildon_stackable_window_map                     (GtkWidget *widget)
     /* Set additional property "_HILDON_STACKABLE_WINDOW", to allow the WM to manage
        it as a stackable window. */
     display = gdk_drawable_get_display (widget->window);
-    atom = gdk_x11_get_xatom_by_name_for_display (display, "_HILDON_STACKABLE_WINDOW");
+    atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_STACKABLE_WINDOW);
     XChangeProperty (GDK_DISPLAY_XDISPLAY (display), GDK_WINDOW_XID (widget->window), atom,
                      XA_INTEGER, 32, PropModeReplace,
                      (unsigned char *) &val, 1);
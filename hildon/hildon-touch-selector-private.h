@@ -25,12 +25,25 @@
 
 G_BEGIN_DECLS
 
+typedef struct                                  _HildonTouchSelectorSnapshot HildonTouchSelectorSnapshot;
+
 void G_GNUC_INTERNAL
 hildon_touch_selector_block_changed             (HildonTouchSelector *selector);
 
 void G_GNUC_INTERNAL
 hildon_touch_selector_unblock_changed           (HildonTouchSelector *selector);
 
+HildonTouchSelectorSnapshot* G_GNUC_INTERNAL
+hildon_touch_selector_snapshot_selection        (HildonTouchSelector *selector,
+                                                 HildonTouchSelectorSnapshot *snapshot);
+
+gboolean G_GNUC_INTERNAL
+hildon_touch_selector_restore_selection         (HildonTouchSelector *selector,
+                                                 HildonTouchSelectorSnapshot *snapshot);
+
+void G_GNUC_INTERNAL
+hildon_touch_selector_snapshot_free             (HildonTouchSelectorSnapshot *snapshot);
+
 G_END_DECLS
 
 #endif
@@ -209,6 +209,9 @@ struct _HildonTouchSelectorColumnPrivate
   GtkWidget *panarea;           /* the pannable widget */
   GtkWidget *vbox;
   GtkTreeRowReference *last_activated;
+
+  /* Bumped whenever the selection or the rows of the column change */
+  guint selection_generation;
 };
 
 struct _HildonTouchSelectorPrivate
@@ -312,6 +315,9 @@ static void
 hildon_touch_selector_emit_value_changed        (HildonTouchSelector *selector,
                                                  gint column);
 
+static void
+hildon_touch_selector_column_watch_filter       (HildonTouchSelectorColumn *column);
+
 /* GtkCellLayout implementation (HildonTouchSelectorColumn)*/
 static void hildon_touch_selector_column_cell_layout_init         (GtkCellLayoutIface      *iface);
 
@@ -828,6 +834,28 @@ _row_tapped_cb (GtkTreeView * tree_view, GtkTreePath * path, gpointer user_data)
 }
 
 
+static void
+hildon_touch_selector_column_invalidate_snapshots (HildonTouchSelectorColumn *column)
+{
+  column->priv->selection_generation++;
+}
+
+/* Rows inserted, deleted or reordered change the index of the selected
+ * rows, so they invalidate selection snapshots too */
+static void
+hildon_touch_selector_column_watch_filter (HildonTouchSelectorColumn *column)
+{
+  g_signal_connect_object (column->priv->filter, "row-inserted",
+                           G_CALLBACK (hildon_touch_selector_column_invalidate_snapshots),
+                           column, G_CONNECT_SWAPPED);
+  g_signal_connect_object (column->priv->filter, "row-deleted",
+                           G_CALLBACK (hildon_touch_selector_column_invalidate_snapshots),
+                           column, G_CONNECT_SWAPPED);
+  g_signal_connect_object (column->priv->filter, "rows-reordered",
+                           G_CALLBACK (hildon_touch_selector_column_invalidate_snapshots),
+                           column, G_CONNECT_SWAPPED);
+}
+
 static HildonTouchSelectorColumn *
 _create_new_column (HildonTouchSelector * selector,
                     GtkTreeModel * model,
@@ -895,6 +923,11 @@ _create_new_column (HildonTouchSelector * selector,
   selection = gtk_tree_view_get_selection (GTK_TREE_VIEW (tv));
   gtk_tree_selection_set_mode (selection, GTK_SELECTION_BROWSE);
 
+  g_signal_connect_object (selection, "changed",
+                           G_CALLBACK (hildon_touch_selector_column_invalidate_snapshots),
+                           new_column, G_CONNECT_SWAPPED);
+  hildon_touch_selector_column_watch_filter (new_column);
+
   /* select the first item */
   *emit_changed = FALSE;
   if ((gtk_tree_model_get_iter_first (filter, &iter))&&
@@ -2244,6 +2277,245 @@ hildon_touch_selector_get_selected_rows (HildonTouchSelector * selector,
   return result;
 }
 
+/* Selection snapshots, used by #HildonPickerDialog to restore the
+ * selection when the dialog is cancelled. A snapshot stores one bit per
+ * top-level row of each column model, together with the generation of
+ * the column when the snapshot was taken. While a column keeps its
+ * generation, its snapshot is known to be current, so saving and
+ * restoring it is free. */
+
+typedef struct
+{
+  HildonTouchSelectorColumn *column;
+  guint generation;
+  gint n_rows;
+  gint n_selected;
+  guint32 *selected;
+} HildonTouchSelectorColumnSnapshot;
+
+struct _HildonTouchSelectorSnapshot
+{
+  gint n_columns;
+  HildonTouchSelectorColumnSnapshot *columns;
+};
+
+#define SNAPSHOT_N_WORDS(n_rows) (((n_rows) + 31) / 32)
+#define SNAPSHOT_BIT(row) (1u << ((row) % 32))
+
+static void
+_column_snapshot_add_row (GtkTreeModel *filter,
+                          GtkTreePath *path,
+                          GtkTreeIter *iter,
+                          gpointer data)
+{
+  HildonTouchSelectorColumnSnapshot *snapshot = data;
+  GtkTreePath *child_path;
+  gint row;
+
+  child_path = gtk_tree_model_filter_convert_path_to_child_path (GTK_TREE_MODEL_FILTER (filter),
+                                                                 path);
+  if (child_path == NULL)
+    return;
+
+  if (gtk_tree_path_get_depth (child_path) == 1) {
+    row = gtk_tree_path_get_indices (child_path)[0];
+    if (row < snapshot->n_rows) {
+      snapshot->selected[row / 32] |= SNAPSHOT_BIT (row);
+      snapshot->n_selected++;
+    }
+  }
+
+  gtk_tree_path_free (child_path);
+}
+
+static void
+_column_snapshot_fill (HildonTouchSelectorColumnSnapshot *snapshot,
+                       HildonTouchSelectorColumn *column)
+{
+  GtkTreeSelection *selection;
+
+  selection = gtk_tree_view_get_selection (column->priv->tree_view);
+
+  snapshot->column = column;
+  snapshot->generation = column->priv->selection_generation;
+  snapshot->n_rows = gtk_tree_model_iter_n_children (column->priv->model, NULL);
+  snapshot->n_selected = 0;
+  snapshot->selected = g_new0 (guint32, SNAPSHOT_N_WORDS (snapshot->n_rows));
+
+  gtk_tree_selection_selected_foreach (selection, _column_snapshot_add_row, snapshot);
+}
+
+/* Selects or unselects the rows of @column whose bit differs between
+ * @saved and @current, so that the selection matches @saved */
+static void
+_column_snapshot_apply (HildonTouchSelectorColumn *column,
+                        HildonTouchSelectorColumnSnapshot *saved,
+                        HildonTouchSelectorColumnSnapshot *current,
+                        gboolean select)
+{
+  GtkTreeSelection *selection;
+  GtkTreeIter iter, filter_iter;
+  gint word, bit;
+
+  selection = gtk_tree_view_get_selection (column->priv->tree_view);
+
+  for (word = 0; word < SNAPSHOT_N_WORDS (current->n_rows); word++) {
+    guint32 saved_word = word < SNAPSHOT_N_WORDS (saved->n_rows) ? saved->selected[word] : 0;
+    guint32 diff = saved_word ^ current->selected[word];
+
+    /* Rows to select are set in the saved snapshot, rows to
+       unselect are set in the current one */
+    diff &= select ? saved_word : current->selected[word];
+
+    for (bit = 0; diff != 0; bit++, diff >>= 1) {
+      gint row = word * 32 + bit;
+
+      if (!(diff & 1) || row >= current->n_rows)
+        continue;
+
+      if (!gtk_tree_model_iter_nth_child (column->priv->model, &iter, NULL, row))
+        continue;
+
+      /* Rows hidden by the live search can't be selected */
+      if (!gtk_tree_model_filter_convert_child_iter_to_iter (GTK_TREE_MODEL_FILTER (column->priv->filter),
+                                                             &filter_iter, &iter))
+        continue;
+
+      if (select)
+        gtk_tree_selection_select_iter (selection, &filter_iter);
+      else
+        gtk_tree_selection_unselect_iter (selection, &filter_iter);
+    }
+  }
+}
+
+static gboolean
+_snapshot_matches_columns (HildonTouchSelector *selector,
+                           HildonTouchSelectorSnapshot *snapshot)
+{
+  GSList *iter;
+  gint i;
+
+  for (iter = selector->priv->columns, i = 0; iter; iter = iter->next, i++) {
+    if (i >= snapshot->n_columns || snapshot->columns[i].column != iter->data)
+      return FALSE;
+  }
+
+  return i == snapshot->n_columns;
+}
+
+/**
+ * hildon_touch_selector_snapshot_selection:
+ * @selector: a #HildonTouchSelector
+ * @snapshot: a previous snapshot of @selector, or %NULL
+ *
+ * Takes a snapshot of the selection of every column of @selector. If
+ * @snapshot is still current, it is returned as is; otherwise it is
+ * freed and a new snapshot is taken.
+ *
+ * Returns: a snapshot, to be freed with hildon_touch_selector_snapshot_free()
+ **/
+HildonTouchSelectorSnapshot *
+hildon_touch_selector_snapshot_selection (HildonTouchSelector *selector,
+                                          HildonTouchSelectorSnapshot *snapshot)
+{
+  GSList *iter;
+  gint i;
+
+  g_return_val_if_fail (HILDON_IS_TOUCH_SELECTOR (selector), snapshot);
+
+  if (snapshot != NULL && _snapshot_matches_columns (selector, snapshot)) {
+    for (i = 0; i < snapshot->n_columns; i++) {
+      if (snapshot->columns[i].generation !=
+          snapshot->columns[i].column->priv->selection_generation)
+        break;
+    }
+    if (i == snapshot->n_columns)
+      return snapshot;
+  }
+
+  if (snapshot != NULL)
+    hildon_touch_selector_snapshot_free (snapshot);
+
+  snapshot = g_slice_new (HildonTouchSelectorSnapshot);
+  snapshot->n_columns = g_slist_length (selector->priv->columns);
+  snapshot->columns = g_new0 (HildonTouchSelectorColumnSnapshot, snapshot->n_columns);
+
+  for (iter = selector->priv->columns, i = 0; iter; iter = iter->next, i++) {
+    _column_snapshot_fill (&snapshot->columns[i], iter->data);
+    g_object_ref (iter->data);
+  }
+
+  return snapshot;
+}
+
+/**
+ * hildon_touch_selector_restore_selection:
+ * @selector: a #HildonTouchSelector
+ * @snapshot: a snapshot of @selector
+ *
+ * Restores the selection saved in @snapshot. Only the columns whose
+ * selection changed since the snapshot was taken are visited, and only
+ * the rows that differ are selected or unselected. As before, columns
+ * that had nothing selected are left untouched.
+ *
+ * Returns: %FALSE if the columns of @selector changed since @snapshot
+ * was taken, %TRUE otherwise
+ **/
+gboolean
+hildon_touch_selector_restore_selection (HildonTouchSelector *selector,
+                                         HildonTouchSelectorSnapshot *snapshot)
+{
+  HildonTouchSelectorColumnSnapshot current;
+  gint i;
+
+  g_return_val_if_fail (HILDON_IS_TOUCH_SELECTOR (selector), FALSE);
+  g_return_val_if_fail (snapshot != NULL, FALSE);
+
+  if (!_snapshot_matches_columns (selector, snapshot))
+    return FALSE;
+
+  for (i = 0; i < snapshot->n_columns; i++) {
+    HildonTouchSelectorColumnSnapshot *saved = &snapshot->columns[i];
+
+    if (saved->generation == saved->column->priv->selection_generation ||
+        saved->n_selected == 0)
+      continue;
+
+    _column_snapshot_fill (&current, saved->column);
+    _column_snapshot_apply (saved->column, saved, &current, FALSE);
+    _column_snapshot_apply (saved->column, saved, &current, TRUE);
+    g_free (current.selected);
+
+    /* The selection matches the snapshot again */
+    saved->generation = saved->column->priv->selection_generation;
+
+    hildon_touch_selector_emit_value_changed (selector, i);
+  }
+
+  return TRUE;
+}
+
+/**
+ * hildon_touch_selector_snapshot_free:
+ * @snapshot: a selection snapshot
+ *
+ * Frees @snapshot.
+ **/
+void
+hildon_touch_selector_snapshot_free (HildonTouchSelectorSnapshot *snapshot)
+{
+  gint i;
+
+  for (i = 0; i < snapshot->n_columns; i++) {
+    g_object_unref (snapshot->columns[i].column);
+    g_free (snapshot->columns[i].selected);
+  }
+
+  g_free (snapshot->columns);
+  g_slice_free (HildonTouchSelectorSnapshot, snapshot);
+}
+
 /**
  * hildon_touch_selector_get_model:
  * @selector: a #HildonTouchSelector
@@ -2360,6 +2632,9 @@ _hildon_touch_selector_set_model (HildonTouchSelector * selector,
   gtk_tree_view_set_model (current_column->priv->tree_view,
                            current_column->priv->filter);
 
+  current_column->priv->selection_generation++;
+  hildon_touch_selector_column_watch_filter (current_column);
+
   g_signal_connect (model, "row-changed",
                     G_CALLBACK (on_row_changed), selector);
   g_signal_connect_after (model, "row-deleted",
@@ -81,6 +81,10 @@ hildon_window_update_topmost                    (HildonWindow *self,
 Window G_GNUC_INTERNAL
 hildon_window_get_active_window                 (void);
 
+void G_GNUC_INTERNAL
+hildon_window_get_topmost_info                  (Window *active_window,
+                                                 XID *active_group);
+
 void G_GNUC_INTERNAL
 hildon_window_update_title                      (HildonWindow *window);
 
@@ -50,17 +50,44 @@
  * several windows at the same time in a single step. See
  * hildon_window_stack_push(), hildon_window_stack_pop() and
  * hildon_window_stack_pop_and_push() for more details.
+ *
+ * Applications that push the same kinds of windows over and over can
+ * register a factory for each window type with
+ * hildon_window_stack_register_factory(). The stack then keeps a pool
+ * of windows of that type, built and realized while the application is
+ * idle, which are handed out by hildon_window_stack_get_pooled_window().
+ * Popped windows can be given back to the pool with
+ * hildon_window_stack_recycle_window() instead of being destroyed. The
+ * time from a push to the first expose of the pushed window is reported
+ * by the #HildonWindowStack::window-presented signal.
  */
 
 #include                                        "hildon-window-stack.h"
 #include                                        "hildon-window-stack-private.h"
 #include                                        "hildon-stackable-window-private.h"
+#include                                        "hildon-marshalers.h"
+
+#define                                         PUSH_TIME_KEY "hildon-window-stack-push-time"
+
+typedef struct
+{
+    GType                     type;
+    HildonWindowStackFactory  factory;
+    gpointer                  user_data;
+    GDestroyNotify            destroy;
+    guint                     size;
+    GQueue                   *windows; /* realized, not stacked */
+    guint                     failed : 1; /* factory returned an invalid window */
+} HildonWindowStackPool;
 
 struct                                          _HildonWindowStackPrivate
 {
     GList *list;
+    guint n_windows; /* length of list */
     GtkWindowGroup *group;
     GdkWindow *leader; /* X Window group hint for all windows in a group */
+    GHashTable *pools; /* GType -> HildonWindowStackPool */
+    guint prewarm_id;
 };
 
 #define                                         HILDON_WINDOW_STACK_GET_PRIVATE(obj) \
@@ -73,6 +100,13 @@ enum {
     PROP_GROUP = 1,
 };
 
+enum {
+    WINDOW_PRESENTED,
+    LAST_SIGNAL
+};
+
+static guint                                    signals[LAST_SIGNAL] = { 0 };
+
 static void
 hildon_window_stack_set_window_group             (HildonWindowStack *stack,
                                                   GtkWindowGroup    *group)
@@ -150,7 +184,7 @@ hildon_window_stack_size                        (HildonWindowStack *stack)
 {
     g_return_val_if_fail (HILDON_IS_WINDOW_STACK (stack), 0);
 
-    return g_list_length (stack->priv->list);
+    return stack->priv->n_windows;
 }
 
 static GdkWindow *
@@ -191,6 +225,32 @@ hildon_window_stack_window_realized             (GtkWidget         *win,
     gdk_window_set_group (win->window, leader);
 }
 
+/* Report the time elapsed between the push of a window and its first
+ * expose */
+static gboolean
+hildon_window_stack_window_exposed              (GtkWidget         *win,
+                                                 GdkEventExpose    *event,
+                                                 HildonWindowStack *stack)
+{
+    GTimeVal *push_time = g_object_get_data (G_OBJECT (win), PUSH_TIME_KEY);
+    GTimeVal now;
+
+    g_signal_handlers_disconnect_by_func (win, hildon_window_stack_window_exposed, stack);
+
+    if (push_time) {
+        gint64 pushed = (gint64) push_time->tv_sec * G_USEC_PER_SEC + push_time->tv_usec;
+        gint64 presented;
+
+        g_get_current_time (&now);
+        presented = (gint64) now.tv_sec * G_USEC_PER_SEC + now.tv_usec;
+
+        g_object_set_data (G_OBJECT (win), PUSH_TIME_KEY, NULL);
+        g_signal_emit (stack, signals[WINDOW_PRESENTED], 0, win, pushed, presented);
+    }
+
+    return FALSE;
+}
+
 /* Remove a window from its stack, no matter its position */
 void G_GNUC_INTERNAL
 hildon_window_stack_remove                      (HildonStackableWindow *win)
@@ -199,7 +259,10 @@ hildon_window_stack_remove                      (HildonStackableWindow *win)
 
     /* If the window is stacked */
     if (stack) {
-        GList *pos;
+        HildonStackableWindowPrivate *priv = HILDON_STACKABLE_WINDOW_GET_PRIVATE (win);
+        GList *pos = priv->stack_link;
+
+        g_assert (pos != NULL && pos->data == win);
 
         hildon_stackable_window_set_stack (win, NULL, -1);
         gtk_window_set_transient_for (GTK_WINDOW (win), NULL);
@@ -209,17 +272,19 @@ hildon_window_stack_remove                      (HildonStackableWindow *win)
 
         /* If the window removed is in the middle of the stack, update
          * transiency of other windows */
-        pos = g_list_find (stack->priv->list, win);
-        g_assert (pos != NULL);
         if (pos->prev) {
             GtkWindow *upper = GTK_WINDOW (pos->prev->data);
             GtkWindow *lower = pos->next ? GTK_WINDOW (pos->next->data) : NULL;
             gtk_window_set_transient_for (upper, lower);
         }
 
-        stack->priv->list = g_list_remove (stack->priv->list, win);
+        stack->priv->list = g_list_delete_link (stack->priv->list, pos);
+        stack->priv->n_windows--;
+        priv->stack_link = NULL;
 
         g_signal_handlers_disconnect_by_func (win, hildon_window_stack_window_realized, stack);
+        g_signal_handlers_disconnect_by_func (win, hildon_window_stack_window_exposed, stack);
+        g_object_set_data (G_OBJECT (win), PUSH_TIME_KEY, NULL);
     }
 }
 
@@ -294,6 +359,8 @@ _hildon_window_stack_do_push                    (HildonWindowStack     *stack,
         /* Push the window */
         hildon_stackable_window_set_stack (win, stack, pos);
         stack->priv->list = g_list_prepend (stack->priv->list, win);
+        stack->priv->n_windows++;
+        HILDON_STACKABLE_WINDOW_GET_PRIVATE (win)->stack_link = stack->priv->list;
 
         /* Make the window part of the same group as its parent */
         if (parent) {
@@ -311,6 +378,17 @@ _hildon_window_stack_do_push                    (HildonWindowStack     *stack,
                               stack);
         }
 
+        /* Measure the time until the window is first drawn */
+        if (g_signal_has_handler_pending (stack, signals[WINDOW_PRESENTED], 0, FALSE)) {
+            GTimeVal *push_time = g_new (GTimeVal, 1);
+
+            g_get_current_time (push_time);
+            g_object_set_data_full (G_OBJECT (win), PUSH_TIME_KEY, push_time, g_free);
+            g_signal_connect_after (win, "expose-event",
+                                    G_CALLBACK (hildon_window_stack_window_exposed),
+                                    stack);
+        }
+
         return TRUE;
     } else {
         g_warning ("Trying to push a window that is already on a stack");
@@ -469,7 +547,7 @@ hildon_window_stack_pop                         (HildonWindowStack  *stack,
 
     g_return_if_fail (HILDON_IS_WINDOW_STACK (stack));
     g_return_if_fail (nwindows > 0);
-    g_return_if_fail (g_list_length (stack->priv->list) >= nwindows);
+    g_return_if_fail (stack->priv->n_windows >= nwindows);
 
     /* Pop windows */
     for (i = 0; i < nwindows; i++) {
@@ -515,11 +593,12 @@ hildon_window_stack_pop_and_push_list           (HildonWindowStack  *stack,
     GList *l;
     GList *popped = NULL;
     GList *pushed = NULL;
+    GHashTable *to_push;
     HildonStackableWindowPrivate *priv;
 
     g_return_if_fail (HILDON_IS_WINDOW_STACK (stack));
     g_return_if_fail (nwindows > 0);
-    g_return_if_fail (g_list_length (stack->priv->list) >= nwindows);
+    g_return_if_fail (stack->priv->n_windows >= nwindows);
 
     /*
      * We need to call gdk_flush() because the application that called us might
@@ -529,6 +608,12 @@ hildon_window_stack_pop_and_push_list           (HildonWindowStack  *stack,
      */
     gdk_flush ();
 
+    /* Windows in @list, to tell in constant time whether a popped window
+     * is pushed back */
+    to_push = g_hash_table_new (NULL, NULL);
+    for (l = list; l != NULL; l = l->next)
+        g_hash_table_insert (to_push, l->data, l->data);
+
     /* Store the index of the topmost window */
     priv = HILDON_STACKABLE_WINDOW_GET_PRIVATE (hildon_window_stack_peek (stack));
     topmost_index = priv->stack_position;
@@ -540,7 +625,7 @@ hildon_window_stack_pop_and_push_list           (HildonWindowStack  *stack,
         /* Hide now windows that are popped and then pushed back.
            This way all the windows that has a changed stack index
            will be unmapped and mapped again. */
-        if (g_list_find (list, win) != NULL) {
+        if (g_hash_table_lookup (to_push, win) != NULL) {
             gtk_widget_hide (win);
         }
     }
@@ -570,11 +655,12 @@ hildon_window_stack_pop_and_push_list           (HildonWindowStack  *stack,
 
     /* Hide windows that are popped but not pushed back (topmost last) */
     for (l = popped; l != NULL; l = l->next) {
-        if (g_list_find (list, l->data) == NULL) {
+        if (g_hash_table_lookup (to_push, l->data) == NULL) {
             gtk_widget_hide (GTK_WIDGET (l->data));
         }
     }
 
+    g_hash_table_destroy (to_push);
     g_list_free (pushed);
     if (popped_windows) {
         *popped_windows = popped;
@@ -628,11 +714,230 @@ hildon_window_stack_pop_and_push                (HildonWindowStack      *stack,
     g_list_free (list);
 }
 
+static void
+hildon_window_stack_pool_free                   (HildonWindowStackPool *pool)
+{
+    GtkWidget *win;
+
+    while ((win = g_queue_pop_head (pool->windows)) != NULL)
+        gtk_widget_destroy (win);
+
+    g_queue_free (pool->windows);
+
+    if (pool->destroy)
+        pool->destroy (pool->user_data);
+
+    g_slice_free (HildonWindowStackPool, pool);
+}
+
+static GtkWidget *
+hildon_window_stack_pool_create_window          (HildonWindowStack     *stack,
+                                                 HildonWindowStackPool *pool)
+{
+    HildonStackableWindow *win;
+
+    if (pool->factory)
+        win = pool->factory (stack, pool->user_data);
+    else
+        win = g_object_new (pool->type, NULL);
+
+    if (!G_TYPE_CHECK_INSTANCE_TYPE (win, pool->type)) {
+        g_warning ("%s: factory for type %s returned an invalid window",
+                   G_STRFUNC, g_type_name (pool->type));
+        if (GTK_IS_WIDGET (win))
+            gtk_widget_destroy (GTK_WIDGET (win));
+        pool->failed = TRUE;
+        return NULL;
+    }
+
+    return GTK_WIDGET (win);
+}
+
+/* Builds and realizes one missing pooled window per iteration, so idle
+ * time is never blocked for long. Pools whose factory failed are not
+ * refilled until they are registered again */
+static gboolean
+hildon_window_stack_prewarm                     (gpointer data)
+{
+    HildonWindowStack *stack = HILDON_WINDOW_STACK (data);
+    HildonWindowStackPool *pool;
+    GHashTableIter iter;
+
+    g_hash_table_iter_init (&iter, stack->priv->pools);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &pool)) {
+        if (!pool->failed && g_queue_get_length (pool->windows) < pool->size) {
+            GtkWidget *win = hildon_window_stack_pool_create_window (stack, pool);
+
+            if (win != NULL) {
+                gtk_widget_realize (win);
+                g_queue_push_tail (pool->windows, win);
+            }
+
+            return TRUE;
+        }
+    }
+
+    stack->priv->prewarm_id = 0;
+    return FALSE;
+}
+
+static void
+hildon_window_stack_schedule_prewarm            (HildonWindowStack *stack)
+{
+    if (stack->priv->prewarm_id == 0)
+        stack->priv->prewarm_id =
+            gdk_threads_add_idle_full (G_PRIORITY_LOW, hildon_window_stack_prewarm,
+                                       stack, NULL);
+}
+
+/**
+ * hildon_window_stack_register_factory:
+ * @stack: A #HildonWindowStack
+ * @window_type: a subtype of #HildonStackableWindow
+ * @factory: function that builds a window of @window_type, or %NULL to
+ * use g_object_new() without properties
+ * @user_data: data to pass to @factory
+ * @destroy: function to free @user_data, or %NULL
+ * @pool_size: number of windows of @window_type to keep ready
+ *
+ * Makes @stack keep up to @pool_size windows of @window_type built and
+ * realized, so pushing them only requires mapping them. The windows are
+ * created while the application is idle. A previous registration for
+ * @window_type is replaced, and its pooled windows are destroyed.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_window_stack_register_factory            (HildonWindowStack        *stack,
+                                                 GType                     window_type,
+                                                 HildonWindowStackFactory  factory,
+                                                 gpointer                  user_data,
+                                                 GDestroyNotify            destroy,
+                                                 guint                     pool_size)
+{
+    HildonWindowStackPool *pool;
+
+    g_return_if_fail (HILDON_IS_WINDOW_STACK (stack));
+    g_return_if_fail (g_type_is_a (window_type, HILDON_TYPE_STACKABLE_WINDOW));
+
+    pool = g_slice_new0 (HildonWindowStackPool);
+    pool->type = window_type;
+    pool->factory = factory;
+    pool->user_data = user_data;
+    pool->destroy = destroy;
+    pool->size = pool_size;
+    pool->windows = g_queue_new ();
+
+    g_hash_table_replace (stack->priv->pools, GSIZE_TO_POINTER (window_type), pool);
+
+    hildon_window_stack_schedule_prewarm (stack);
+}
+
+/**
+ * hildon_window_stack_unregister_factory:
+ * @stack: A #HildonWindowStack
+ * @window_type: a type registered with hildon_window_stack_register_factory()
+ *
+ * Stops pooling windows of @window_type and destroys the pooled ones.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_window_stack_unregister_factory          (HildonWindowStack *stack,
+                                                 GType              window_type)
+{
+    g_return_if_fail (HILDON_IS_WINDOW_STACK (stack));
+
+    g_hash_table_remove (stack->priv->pools, GSIZE_TO_POINTER (window_type));
+}
+
+/**
+ * hildon_window_stack_get_pooled_window:
+ * @stack: A #HildonWindowStack
+ * @window_type: a type registered with hildon_window_stack_register_factory()
+ *
+ * Takes a window of @window_type from the pool of @stack. If the pool is
+ * empty, a new window is built with the registered factory. The pool is
+ * refilled later, when the application is idle. The window is not
+ * stacked: push it as any other window.
+ *
+ * Return value: a #HildonStackableWindow of @window_type, or %NULL if
+ * no factory is registered for it
+ *
+ * Since: 2.2.25
+ **/
+GtkWidget *
+hildon_window_stack_get_pooled_window           (HildonWindowStack *stack,
+                                                 GType              window_type)
+{
+    HildonWindowStackPool *pool;
+    GtkWidget *win;
+
+    g_return_val_if_fail (HILDON_IS_WINDOW_STACK (stack), NULL);
+
+    pool = g_hash_table_lookup (stack->priv->pools, GSIZE_TO_POINTER (window_type));
+    if (pool == NULL) {
+        g_warning ("%s: no factory registered for type %s",
+                   G_STRFUNC, g_type_name (window_type));
+        return NULL;
+    }
+
+    win = g_queue_pop_head (pool->windows);
+    if (win == NULL)
+        win = hildon_window_stack_pool_create_window (stack, pool);
+
+    hildon_window_stack_schedule_prewarm (stack);
+
+    return win;
+}
+
+/**
+ * hildon_window_stack_recycle_window:
+ * @stack: A #HildonWindowStack
+ * @win: a #HildonStackableWindow that is not stacked
+ *
+ * Gives @win back to the pool of its type, so it can be returned again
+ * by hildon_window_stack_get_pooled_window(). The window keeps its
+ * contents, so only recycle windows that can be reused as they are. If
+ * no factory is registered for the type of @win or its pool is full,
+ * @win is destroyed.
+ *
+ * Since: 2.2.25
+ **/
+void
+hildon_window_stack_recycle_window              (HildonWindowStack     *stack,
+                                                 HildonStackableWindow *win)
+{
+    HildonWindowStackPool *pool;
+
+    g_return_if_fail (HILDON_IS_WINDOW_STACK (stack));
+    g_return_if_fail (HILDON_IS_STACKABLE_WINDOW (win));
+    g_return_if_fail (hildon_stackable_window_get_stack (win) == NULL);
+
+    pool = g_hash_table_lookup (stack->priv->pools,
+                                GSIZE_TO_POINTER (G_OBJECT_TYPE (win)));
+
+    if (pool && g_queue_find (pool->windows, win))
+        return;
+
+    if (pool && g_queue_get_length (pool->windows) < pool->size) {
+        gtk_widget_hide (GTK_WIDGET (win));
+        g_queue_push_tail (pool->windows, win);
+    } else {
+        gtk_widget_destroy (GTK_WIDGET (win));
+    }
+}
+
 static void
 hildon_window_stack_finalize (GObject *object)
 {
     HildonWindowStack *stack = HILDON_WINDOW_STACK (object);
 
+    if (stack->priv->prewarm_id)
+        g_source_remove (stack->priv->prewarm_id);
+
+    g_hash_table_destroy (stack->priv->pools);
+
     if (stack->priv->list)
         hildon_window_stack_pop (stack, hildon_window_stack_size (stack), NULL);
 
@@ -704,6 +1009,29 @@ hildon_window_stack_class_init (HildonWindowStackClass *klass)
             GTK_TYPE_WINDOW_GROUP,
             G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
 
+    /**
+     * HildonWindowStack::window-presented:
+     * @stack: the #HildonWindowStack that received the signal
+     * @window: the pushed #HildonStackableWindow
+     * @push_time: when @window was pushed, in microseconds since the Epoch
+     * @present_time: when @window was first exposed, in microseconds since
+     * the Epoch
+     *
+     * Emitted when a window pushed to @stack is drawn for the first
+     * time. Pushes are only timed while this signal has handlers.
+     *
+     * Since: 2.2.25
+     */
+    signals[WINDOW_PRESENTED] =
+        g_signal_new ("window-presented",
+                      G_TYPE_FROM_CLASS (klass),
+                      G_SIGNAL_RUN_LAST,
+                      0, NULL, NULL,
+                      _hildon_marshal_VOID__OBJECT_INT64_INT64,
+                      G_TYPE_NONE, 3,
+                      HILDON_TYPE_STACKABLE_WINDOW,
+                      G_TYPE_INT64, G_TYPE_INT64);
+
     g_type_class_add_private (klass, sizeof (HildonWindowStackPrivate));
 }
 
@@ -715,5 +1043,9 @@ hildon_window_stack_init (HildonWindowStack *self)
     priv = self->priv = HILDON_WINDOW_STACK_GET_PRIVATE (self);
 
     priv->list = NULL;
+    priv->n_windows = 0;
     priv->group = NULL;
+    priv->pools = g_hash_table_new_full (NULL, NULL, NULL,
+                                         (GDestroyNotify) hildon_window_stack_pool_free);
+    priv->prewarm_id = 0;
 }
@@ -80,6 +80,21 @@ struct                                          _HildonWindowStackClass
     void (*_hildon_reserved4)(void);
 };
 
+/**
+ * HildonWindowStackFactory:
+ * @stack: the #HildonWindowStack filling its pool
+ * @user_data: the data passed to hildon_window_stack_register_factory()
+ *
+ * Function that builds a new window for the pool of a
+ * #HildonWindowStack.
+ *
+ * Returns: a new #HildonStackableWindow
+ *
+ * Since: 2.2.25
+ **/
+typedef HildonStackableWindow * (*HildonWindowStackFactory) (HildonWindowStack *stack,
+                                                             gpointer           user_data);
+
 GType
 hildon_window_stack_get_type                    (void) G_GNUC_CONST;
 
@@ -132,6 +147,26 @@ hildon_window_stack_pop_and_push_list           (HildonWindowStack  *stack,
                                                  GList             **popped_windows,
                                                  GList              *list);
 
+void
+hildon_window_stack_register_factory            (HildonWindowStack        *stack,
+                                                 GType                     window_type,
+                                                 HildonWindowStackFactory  factory,
+                                                 gpointer                  user_data,
+                                                 GDestroyNotify            destroy,
+                                                 guint                     pool_size);
+
+void
+hildon_window_stack_unregister_factory          (HildonWindowStack *stack,
+                                                 GType              window_type);
+
+GtkWidget *
+hildon_window_stack_get_pooled_window           (HildonWindowStack *stack,
+                                                 GType              window_type);
+
+void
+hildon_window_stack_recycle_window              (HildonWindowStack     *stack,
+                                                 HildonStackableWindow *win);
+
 G_END_DECLS
 
 #endif                                          /* __HILDON_WINDOW_STACK_H__ */
@@ -96,6 +96,7 @@
 #include                                        "hildon-find-toolbar.h"
 #include                                        "hildon-defines.h"
 #include                                        "hildon-private.h"
+#include                                        "hildon-program-private.h"
 
 #define                                         _(String) gettext(String)
 
@@ -108,15 +109,24 @@
 
 #define                                         CAN_HIBERNATE_LENGTH 7
 
-#define                                         CAN_HIBERNATE_PROPERTY "_HILDON_ABLE_TO_HIBERNATE"
-
-#define                                         LEGACY_MENU_PROPERTY_NAME  "_HILDON_WM_WINDOW_TYPE"
-#define                                         LEGACY_MENU_PROPERTY_VALUE "_HILDON_WM_WINDOW_TYPE_LEGACY_MENU"
-
 #define TITLE_SEPARATOR                         " - "
 
 typedef void                                    (*HildonWindowSignal) (HildonWindow *, gint, gpointer);
 
+/* Process-wide cache of the _MB_CURRENT_APP_WINDOW root property. It is
+ * read once per change and shared by all the realized windows and their
+ * programs, instead of every filter querying the server on its own */
+typedef struct
+{
+    Window    active_window;
+    XID       active_group;
+    gboolean  valid;
+    guint     update_id;
+    GSList   *windows;
+}                                               HildonTopmostTracker;
+
+static HildonTopmostTracker                     topmost_tracker = { None, None, FALSE, 0, NULL };
+
 static void
 hildon_window_init                              (HildonWindow * self);
 
@@ -423,7 +433,8 @@ hildon_window_realize                           (GtkWidget *widget)
     memcpy (new_atoms, old_atoms, sizeof(Atom) * atom_count);
 
     new_atoms[atom_count++] =
-        XInternAtom (disp, "_NET_WM_CONTEXT_CUSTOM", False);
+        hildon_private_get_xatom (gtk_widget_get_display (widget),
+                                  HILDON_ATOM_NET_WM_CONTEXT_CUSTOM);
 
     XSetWMProtocols (disp, window, new_atoms, atom_count);
 
@@ -444,7 +455,8 @@ hildon_window_realize                           (GtkWidget *widget)
         hildon_window_update_markup (HILDON_WINDOW (widget));
 
     /* Update the topmost status */
-    active_window = hildon_window_get_active_window();
+    topmost_tracker.windows = g_slist_prepend (topmost_tracker.windows, widget);
+    hildon_window_get_topmost_info (&active_window, NULL);
     hildon_window_update_topmost (HILDON_WINDOW (widget), active_window);
 }
 
@@ -459,6 +471,19 @@ hildon_window_unrealize                         (GtkWidget *widget)
 
     hildon_window_update_topmost (HILDON_WINDOW (widget), 0);
 
+    topmost_tracker.windows = g_slist_remove (topmost_tracker.windows, widget);
+
+    /* Changes are only seen through the filters of realized windows */
+    if (topmost_tracker.windows == NULL)
+    {
+        topmost_tracker.valid = FALSE;
+        if (topmost_tracker.update_id)
+        {
+            g_source_remove (topmost_tracker.update_id);
+            topmost_tracker.update_id = 0;
+        }
+    }
+
     gtk_widget_unrealize (GTK_WIDGET (priv->vbox));
 
     if (priv->edit_toolbar != NULL)
@@ -1024,8 +1049,8 @@ hildon_window_get_active_window                 (void)
         Window *win;
         unsigned char *char_pointer;
     } win;
-    Atom active_app_atom = 
-        XInternAtom (GDK_DISPLAY (), "_MB_CURRENT_APP_WINDOW", False);
+    Atom active_app_atom =
+        hildon_private_get_xatom (NULL, HILDON_ATOM_MB_CURRENT_APP_WINDOW);
 
     win.win = NULL;
 
@@ -1053,11 +1078,108 @@ hildon_window_get_active_window                 (void)
     return (ret != 0xFFFFFFFF) ? ret : None;
 }
 
+static void
+hildon_window_topmost_tracker_refresh           (void)
+{
+    XWMHints *wm_hints = NULL;
+    gint xerror;
+
+    topmost_tracker.active_window = hildon_window_get_active_window ();
+    topmost_tracker.active_group = None;
+    topmost_tracker.valid = TRUE;
+
+    if (topmost_tracker.active_window == None)
+        return;
+
+    gdk_error_trap_push ();
+    wm_hints = XGetWMHints (GDK_DISPLAY (), topmost_tracker.active_window);
+    xerror = gdk_error_trap_pop ();
+
+    if (wm_hints)
+    {
+        if (!xerror && (wm_hints->flags & WindowGroupHint))
+            topmost_tracker.active_group = wm_hints->window_group;
+        XFree (wm_hints);
+    }
+}
+
+static gboolean
+hildon_window_topmost_tracker_update            (gpointer data)
+{
+    GSList *windows, *iter, *programs = NULL;
+
+    topmost_tracker.update_id = 0;
+
+    hildon_window_topmost_tracker_refresh ();
+
+    windows = g_slist_copy (topmost_tracker.windows);
+    g_slist_foreach (windows, (GFunc) g_object_ref, NULL);
+
+    for (iter = windows; iter != NULL; iter = iter->next)
+    {
+        HildonWindowPrivate *priv = HILDON_WINDOW_GET_PRIVATE (iter->data);
+
+        if (priv->program && !g_slist_find (programs, priv->program))
+            programs = g_slist_prepend (programs, priv->program);
+    }
+
+    /* The programs update all of their windows */
+    for (iter = programs; iter != NULL; iter = iter->next)
+        hildon_program_update_top_most (iter->data);
+
+    for (iter = windows; iter != NULL; iter = iter->next)
+    {
+        HildonWindowPrivate *priv = HILDON_WINDOW_GET_PRIVATE (iter->data);
+
+        if (priv->program == NULL)
+            hildon_window_update_topmost (iter->data, topmost_tracker.active_window);
+    }
+
+    g_slist_foreach (windows, (GFunc) g_object_unref, NULL);
+    g_slist_free (windows);
+    g_slist_free (programs);
+
+    return FALSE;
+}
+
+/*
+ * Gets the cached topped window and its window group, reading them from
+ * the server only if no change has been tracked yet. Either pointer can
+ * be NULL.
+ */
+void
+hildon_window_get_topmost_info                  (Window *active_window,
+                                                 XID *active_group)
+{
+    if (!topmost_tracker.valid)
+        hildon_window_topmost_tracker_refresh ();
+
+    if (active_window)
+        *active_window = topmost_tracker.active_window;
+    if (active_group)
+        *active_group = topmost_tracker.active_group;
+}
+
+/*
+ * Called by the event filters when _MB_CURRENT_APP_WINDOW changes. All
+ * the notifications received in the same main loop iteration result in a
+ * single read of the property.
+ */
+static void
+hildon_window_topmost_tracker_queue_update      (void)
+{
+    if (topmost_tracker.update_id == 0)
+        topmost_tracker.update_id =
+            gdk_threads_add_idle_full (G_PRIORITY_HIGH_IDLE,
+                                       hildon_window_topmost_tracker_update,
+                                       NULL, NULL);
+}
+
 static int
-xclient_message_type_check                      (XClientMessageEvent *cm, 
-                                                 const gchar *name)
+xclient_message_type_check                      (XClientMessageEvent *cm,
+                                                 HildonAtom atom)
 {
-    return cm->message_type == XInternAtom(GDK_DISPLAY(), name, FALSE);
+    return cm->message_type == hildon_private_get_xatom (NULL, atom);
 }
 
 /*
@@ -1075,25 +1197,25 @@ hildon_window_event_filter                      (GdkXEvent *xevent,
     {
         XClientMessageEvent *cm = xevent;
 
-        if (xclient_message_type_check (cm, "_MB_GRAB_TRANSFER"))
+        if (xclient_message_type_check (cm, HILDON_ATOM_MB_GRAB_TRANSFER))
         {
             hildon_window_toggle_menu (HILDON_WINDOW ( data ), cm->data.l[2], cm->data.l[0]);
             return GDK_FILTER_REMOVE;
         }
         /* opera hack clipboard client message */
-        else if (xclient_message_type_check (cm, "_HILDON_IM_CLIPBOARD_COPY"))
+        else if (xclient_message_type_check (cm, HILDON_ATOM_HILDON_IM_CLIPBOARD_COPY))
         {
             g_signal_emit_by_name(G_OBJECT(data), "clipboard_operation",
                     HILDON_WINDOW_CO_COPY);
             return GDK_FILTER_REMOVE;
         }
-        else if (xclient_message_type_check(cm, "_HILDON_IM_CLIPBOARD_CUT"))
+        else if (xclient_message_type_check (cm, HILDON_ATOM_HILDON_IM_CLIPBOARD_CUT))
         {
             g_signal_emit_by_name(G_OBJECT(data), "clipboard_operation",
                     HILDON_WINDOW_CO_CUT);
             return GDK_FILTER_REMOVE;
         }
-        else if (xclient_message_type_check(cm, "_HILDON_IM_CLIPBOARD_PASTE"))
+        else if (xclient_message_type_check (cm, HILDON_ATOM_HILDON_IM_CLIPBOARD_PASTE))
         {
             g_signal_emit_by_name(G_OBJECT(data), "clipboard_operation",
                     HILDON_WINDOW_CO_PASTE);
@@ -1104,15 +1226,12 @@ hildon_window_event_filter                      (GdkXEvent *xevent,
     if (eventti->type == PropertyNotify)
     {
         XPropertyEvent *pevent = xevent;
-        Atom active_app_atom = 
-            XInternAtom (GDK_DISPLAY (), "_MB_CURRENT_APP_WINDOW", False);
+        Atom active_app_atom =
+            hildon_private_get_xatom (NULL, HILDON_ATOM_MB_CURRENT_APP_WINDOW);
 
         if (pevent->atom == active_app_atom)
         {
-            HildonWindow *window = HILDON_WINDOW (data);
-            Window active_window = hildon_window_get_active_window();
-
-            hildon_window_update_topmost (window, active_window);
+            hildon_window_topmost_tracker_queue_update ();
         }
     }
 
@@ -1224,14 +1343,14 @@ set_legacy_menu_type                            (GtkMenu  *menu,
                                                  gboolean  set)
 {
     GdkWindow *gdkwin = GTK_WIDGET (menu->toplevel)->window;
-    GdkAtom property = gdk_atom_intern_static_string (LEGACY_MENU_PROPERTY_NAME);
+    GdkDisplay *display = gdk_drawable_get_display (gdkwin);
+    Atom property = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_WM_WINDOW_TYPE);
     if (set) {
-        GdkAtom type = gdk_x11_xatom_to_atom (XA_ATOM);
-        GdkAtom value = gdk_atom_intern_static_string (LEGACY_MENU_PROPERTY_VALUE);
-        gdk_property_change (gdkwin, property, type, 32,
-                             GDK_PROP_MODE_REPLACE, (const guchar *) &value, 1);
+        Atom value = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_WM_WINDOW_TYPE_LEGACY_MENU);
+        XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin),
+                         property, XA_ATOM, 32, PropModeReplace, (guchar *) &value, 1);
     } else {
-        gdk_property_delete (gdkwin, property);
+        XDeleteProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin), property);
     }
 }
 
@@ -1404,7 +1523,8 @@ void G_GNUC_INTERNAL
 hildon_window_set_can_hibernate_property        (HildonWindow *self, 
                                                  gpointer _can_hibernate)
 {
-    GdkAtom killable_atom;
+    GdkWindow *gdkwin;
+    Atom killable_atom;
     gboolean can_hibernate;
 
     g_return_if_fail(self && HILDON_IS_WINDOW (self));
@@ -1416,18 +1536,19 @@ hildon_window_set_can_hibernate_property        (HildonWindow *self,
 
     can_hibernate = * ((gboolean *)_can_hibernate);
 
-    killable_atom = gdk_atom_intern (CAN_HIBERNATE_PROPERTY, FALSE);
+    gdkwin = GTK_WIDGET (self)->window;
+    killable_atom = hildon_private_get_xatom (gdk_drawable_get_display (gdkwin),
+                                              HILDON_ATOM_HILDON_ABLE_TO_HIBERNATE);
 
     if (can_hibernate)
     {
-        gdk_property_change (GTK_WIDGET (self)->window, killable_atom,
-                (GdkAtom)31/* XA_STRING */, 8,
-                GDK_PROP_MODE_REPLACE, (const guchar *)CAN_HIBERNATE,
-                CAN_HIBERNATE_LENGTH);
+        XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin),
+                killable_atom, XA_STRING, 8, PropModeReplace,
+                (guchar *) CAN_HIBERNATE, CAN_HIBERNATE_LENGTH);
     }
     else
     {
-        gdk_property_delete (GTK_WIDGET (self)->window, killable_atom);
+        XDeleteProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin), killable_atom);
     }
 
 }
@@ -2114,6 +2235,7 @@ hildon_window_set_app_menu                      (HildonWindow  *self,
     {
         g_object_ref_sink (menu);
         g_signal_connect (menu, "changed", G_CALLBACK (on_menu_changed), self);
+        hildon_app_menu_prepare (menu);
     }
 
     /* Unref old menu */
@@ -2156,16 +2278,16 @@ static void
 hildon_window_update_markup                     (HildonWindow *window)
 {
     HildonWindowPrivate *priv = HILDON_WINDOW_GET_PRIVATE (window);
-    GdkAtom markup_atom = gdk_atom_intern ("_HILDON_WM_NAME", FALSE);
-    GdkAtom utf8_atom = gdk_atom_intern ("UTF8_STRING", FALSE);
     GdkWindow *gdkwin = GTK_WIDGET (window)->window;
+    GdkDisplay *display = gdk_drawable_get_display (gdkwin);
+    Atom markup_atom = hildon_private_get_xatom (display, HILDON_ATOM_HILDON_WM_NAME);
 
     if (priv->markup) {
-        gdk_property_change (gdkwin, markup_atom, utf8_atom, 8,
-                             GDK_PROP_MODE_REPLACE, (const guchar *) priv->markup,
-                             strlen (priv->markup));
+        XChangeProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin), markup_atom,
+                         hildon_private_get_xatom (display, HILDON_ATOM_UTF8_STRING), 8,
+                         PropModeReplace, (guchar *) priv->markup, strlen (priv->markup));
     } else {
-        gdk_property_delete (gdkwin, markup_atom);
+        XDeleteProperty (GDK_WINDOW_XDISPLAY (gdkwin), GDK_WINDOW_XID (gdkwin), markup_atom);
     }
 }
 
@@ -71,6 +71,8 @@
 #include                                        "hildon-stackable-window.h"
 #include                                        "hildon-window-stack.h"
 #include                                        "hildon-animation-actor.h"
+#include                                        "hildon-animation-timeline.h"
+#include                                        "hildon-size-group.h"
 #include                                        "hildon-wizard-dialog.h"
 #include                                        "hildon-calendar.h"
 #include                                        "hildon-bread-crumb-trail.h"
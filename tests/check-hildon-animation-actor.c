@@ -0,0 +1,422 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include <gdk/gdkx.h>
+#include <X11/Xatom.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+static GtkWidget *window = NULL;
+static HildonAnimationActor *actor = NULL;
+
+static Atom position_atom;
+static Atom scale_atom;
+static Atom rotation_atom;
+
+static gint position_messages;
+static gint scale_messages;
+static gint rotation_messages;
+static gint first_x;
+static gint last_x;
+
+/* Counts the messages the actor sends to the window manager, which
+   are delivered to its own window */
+static GdkFilterReturn
+count_messages (GdkXEvent *xevent,
+                GdkEvent *event,
+                gpointer data)
+{
+  XClientMessageEvent *message = xevent;
+
+  if (message->type != ClientMessage)
+    return GDK_FILTER_CONTINUE;
+
+  if (message->message_type == position_atom) {
+    last_x = (gint32) message->data.l[0];
+    if (position_messages++ == 0)
+      first_x = last_x;
+  }
+  else if (message->message_type == scale_atom)
+    scale_messages++;
+  else if (message->message_type == rotation_atom)
+    rotation_messages++;
+
+  return GDK_FILTER_CONTINUE;
+}
+
+static void
+reset_messages (void)
+{
+  position_messages = 0;
+  scale_messages = 0;
+  rotation_messages = 0;
+}
+
+static void
+process_events (void)
+{
+  XSync (GDK_WINDOW_XDISPLAY (GTK_WIDGET (actor)->window), False);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+}
+
+static gboolean
+quit_main_loop (gpointer data)
+{
+  g_main_loop_quit (data);
+
+  return TRUE;
+}
+
+/* Runs the main loop for @msecs, or until @loop is quit */
+static void
+run_main_loop (GMainLoop *loop,
+               guint msecs)
+{
+  guint id;
+
+  id = g_timeout_add (msecs, quit_main_loop, loop);
+  g_main_loop_run (loop);
+  g_source_remove (id);
+
+  process_events ();
+}
+
+static void
+count_completed (HildonAnimationTimeline *timeline,
+                 gpointer data)
+{
+  gint *completed = data;
+
+  (*completed)++;
+}
+
+/* Does what hildon-desktop does once it has created the actor */
+static void
+set_actor_ready (void)
+{
+  GtkWidget *widget = GTK_WIDGET (actor);
+  Display *display = GDK_WINDOW_XDISPLAY (widget->window);
+  Atom ready = XInternAtom (display, "_HILDON_ANIMATION_CLIENT_READY", False);
+
+  XChangeProperty (display, GDK_WINDOW_XID (widget->window), ready,
+                   XA_ATOM, 32, PropModeReplace,
+                   (unsigned char *) &ready, 1);
+
+  process_events ();
+}
+
+static void
+fx_setup_animation_actor ()
+{
+  int argc = 0;
+  Display *display;
+
+  gtk_init (&argc, NULL);
+
+  window = hildon_window_new ();
+  show_test_window (window);
+
+  actor = HILDON_ANIMATION_ACTOR (hildon_animation_actor_new ());
+  fail_if (!HILDON_IS_ANIMATION_ACTOR (actor),
+           "hildon-animation-actor: Creation failed.");
+
+  hildon_animation_actor_set_parent (actor, GTK_WINDOW (window));
+  gtk_widget_show (GTK_WIDGET (actor));
+
+  display = GDK_WINDOW_XDISPLAY (GTK_WIDGET (actor)->window);
+  position_atom = XInternAtom (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_POSITION", False);
+  scale_atom = XInternAtom (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_SCALE", False);
+  rotation_atom = XInternAtom (display, "_HILDON_ANIMATION_CLIENT_MESSAGE_ROTATION", False);
+  gdk_window_add_filter (GTK_WIDGET (actor)->window, count_messages, NULL);
+
+  process_events ();
+  reset_messages ();
+}
+
+static void
+fx_teardown_animation_actor ()
+{
+  gdk_window_remove_filter (GTK_WIDGET (actor)->window, count_messages, NULL);
+  gtk_widget_destroy (GTK_WIDGET (actor));
+  gtk_widget_destroy (window);
+}
+
+/**
+ * Purpose: Check that property changes made in a transaction are sent
+ *          when it is committed
+ * Cases considered:
+ *    - Change several properties, one of them twice, in a transaction.
+ *    - Change a property in nested transactions.
+ *    - Set a property to the value already sent.
+ */
+START_TEST (test_animation_actor_transaction)
+{
+  set_actor_ready ();
+  reset_messages ();
+
+  /* Test 1: only the last value of each property is sent */
+  hildon_animation_actor_begin_transaction (actor);
+  hildon_animation_actor_set_position (actor, 10, 20);
+  hildon_animation_actor_set_position (actor, 30, 40);
+  hildon_animation_actor_set_scale (actor, 2.0, 2.0);
+  hildon_animation_actor_set_rotation (actor, HILDON_AA_Z_AXIS, 45.0, 0, 0, 0);
+  process_events ();
+
+  fail_if (position_messages + scale_messages + rotation_messages != 0,
+           "hildon-animation-actor: Messages sent during a transaction");
+
+  hildon_animation_actor_commit_transaction (actor);
+  process_events ();
+
+  fail_if (position_messages != 1 || scale_messages != 1 || rotation_messages != 1,
+           "hildon-animation-actor: Wrong messages sent on commit "
+           "(position %d, scale %d, rotation %d)",
+           position_messages, scale_messages, rotation_messages);
+
+  /* Test 2: nested transactions are sent by the outermost commit */
+  reset_messages ();
+  hildon_animation_actor_begin_transaction (actor);
+  hildon_animation_actor_begin_transaction (actor);
+  hildon_animation_actor_set_position (actor, 50, 60);
+  hildon_animation_actor_commit_transaction (actor);
+  process_events ();
+
+  fail_if (position_messages != 0,
+           "hildon-animation-actor: Inner commit sent the transaction");
+
+  hildon_animation_actor_commit_transaction (actor);
+  process_events ();
+
+  fail_if (position_messages != 1,
+           "hildon-animation-actor: %d position messages sent by the outer commit instead of 1",
+           position_messages);
+
+  /* Test 3: unchanged values are not sent again */
+  reset_messages ();
+  hildon_animation_actor_set_position (actor, 50, 60);
+  hildon_animation_actor_begin_transaction (actor);
+  hildon_animation_actor_set_scale (actor, 2.0, 2.0);
+  hildon_animation_actor_commit_transaction (actor);
+  process_events ();
+
+  fail_if (position_messages != 0 || scale_messages != 0,
+           "hildon-animation-actor: Unchanged properties were sent again");
+}
+END_TEST
+
+/**
+ * Purpose: Check that a transaction committed before the window manager
+ *          is ready is sent once it is
+ * Cases considered:
+ *    - Commit a transaction before the actor is ready.
+ *    - Make the actor ready.
+ */
+START_TEST (test_animation_actor_transaction_pending)
+{
+  hildon_animation_actor_begin_transaction (actor);
+  hildon_animation_actor_set_position (actor, 10, 20);
+  hildon_animation_actor_set_scale (actor, 0.5, 0.5);
+  hildon_animation_actor_commit_transaction (actor);
+  process_events ();
+
+  fail_if (position_messages + scale_messages != 0,
+           "hildon-animation-actor: Messages sent before the actor was ready");
+
+  set_actor_ready ();
+
+  fail_if (position_messages != 1 || scale_messages != 1,
+           "hildon-animation-actor: Queued transaction not sent once ready "
+           "(position %d, scale %d)",
+           position_messages, scale_messages);
+}
+END_TEST
+
+/**
+ * Purpose: Check the keyframes of a timeline
+ * Cases considered:
+ *    - Add keyframes to several properties.
+ *    - Replace an existing keyframe.
+ *    - Clear the keyframes.
+ *    - Set and get the loop flag.
+ */
+START_TEST (test_animation_timeline_keyframes)
+{
+  HildonAnimationTimeline *timeline;
+
+  timeline = hildon_animation_timeline_new (actor);
+  fail_if (hildon_animation_timeline_get_actor (timeline) != actor,
+           "hildon-animation-timeline: Wrong actor");
+  fail_if (hildon_animation_timeline_get_duration (timeline) != 0,
+           "hildon-animation-timeline: New timeline has a duration");
+
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          400, 0, HILDON_ANIMATION_EASING_EASE_OUT);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          0, -200, HILDON_ANIMATION_EASING_LINEAR);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_OPACITY,
+                                          300, 255, HILDON_ANIMATION_EASING_LINEAR);
+  fail_if (hildon_animation_timeline_get_duration (timeline) != 400,
+           "hildon-animation-timeline: Duration is %u instead of 400",
+           hildon_animation_timeline_get_duration (timeline));
+
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          400, 100, HILDON_ANIMATION_EASING_LINEAR);
+  fail_if (hildon_animation_timeline_get_duration (timeline) != 400,
+           "hildon-animation-timeline: Replacing a keyframe changed the duration");
+
+  hildon_animation_timeline_clear_keyframes (timeline);
+  fail_if (hildon_animation_timeline_get_duration (timeline) != 0,
+           "hildon-animation-timeline: Cleared timeline has a duration");
+
+  fail_if (hildon_animation_timeline_get_loop (timeline),
+           "hildon-animation-timeline: New timeline loops");
+  hildon_animation_timeline_set_loop (timeline, TRUE);
+  fail_if (!hildon_animation_timeline_get_loop (timeline),
+           "hildon-animation-timeline: Loop flag not set");
+
+  g_object_unref (timeline);
+}
+END_TEST
+
+/**
+ * Purpose: Check that a timeline drives its actor until it completes
+ * Cases considered:
+ *    - Start a timeline, which applies its first keyframe right away.
+ *    - Let it play until it completes.
+ */
+START_TEST (test_animation_timeline_play)
+{
+  HildonAnimationTimeline *timeline;
+  GMainLoop *loop;
+  gint completed = 0;
+
+  set_actor_ready ();
+  reset_messages ();
+
+  loop = g_main_loop_new (NULL, FALSE);
+  timeline = hildon_animation_timeline_new (actor);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          0, -200, HILDON_ANIMATION_EASING_LINEAR);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          100, 50, HILDON_ANIMATION_EASING_EASE_IN);
+  g_signal_connect (timeline, "completed", G_CALLBACK (count_completed), &completed);
+  g_signal_connect_swapped (timeline, "completed", G_CALLBACK (g_main_loop_quit), loop);
+
+  /* Test 1: the first keyframe is applied by start */
+  hildon_animation_timeline_start (timeline);
+  process_events ();
+
+  fail_if (!hildon_animation_timeline_is_playing (timeline),
+           "hildon-animation-timeline: Timeline not playing after start");
+  fail_if (position_messages == 0 || first_x != -200,
+           "hildon-animation-timeline: First keyframe not applied on start (x %d)",
+           first_x);
+
+  /* Test 2: the last keyframe is applied on completion */
+  run_main_loop (loop, 2000);
+
+  fail_if (completed != 1,
+           "hildon-animation-timeline: \"completed\" emitted %d times", completed);
+  fail_if (hildon_animation_timeline_is_playing (timeline),
+           "hildon-animation-timeline: Timeline still playing after completing");
+  fail_if (last_x != 50,
+           "hildon-animation-timeline: Last keyframe not applied (x %d)", last_x);
+
+  g_object_unref (timeline);
+  g_main_loop_unref (loop);
+}
+END_TEST
+
+/**
+ * Purpose: Check that a looping timeline plays until it is stopped
+ * Cases considered:
+ *    - Play a looping timeline for several times its duration.
+ *    - Stop it, which leaves the actor as it is.
+ */
+START_TEST (test_animation_timeline_loop)
+{
+  HildonAnimationTimeline *timeline;
+  GMainLoop *loop;
+  gint completed = 0;
+
+  set_actor_ready ();
+
+  loop = g_main_loop_new (NULL, FALSE);
+  timeline = hildon_animation_timeline_new (actor);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          0, 0, HILDON_ANIMATION_EASING_LINEAR);
+  hildon_animation_timeline_add_keyframe (timeline, HILDON_ANIMATION_PROPERTY_X,
+                                          50, 100, HILDON_ANIMATION_EASING_LINEAR);
+  hildon_animation_timeline_set_loop (timeline, TRUE);
+  g_signal_connect (timeline, "completed", G_CALLBACK (count_completed), &completed);
+
+  /* Test 1: the timeline keeps playing */
+  hildon_animation_timeline_start (timeline);
+  run_main_loop (loop, 200);
+
+  fail_if (completed != 0,
+           "hildon-animation-timeline: Looping timeline completed");
+  fail_if (!hildon_animation_timeline_is_playing (timeline),
+           "hildon-animation-timeline: Looping timeline stopped playing");
+
+  /* Test 2: nothing is sent once stopped */
+  hildon_animation_timeline_stop (timeline);
+  fail_if (hildon_animation_timeline_is_playing (timeline),
+           "hildon-animation-timeline: Timeline still playing after stop");
+
+  reset_messages ();
+  run_main_loop (loop, 100);
+  fail_if (position_messages != 0,
+           "hildon-animation-timeline: Stopped timeline moved the actor");
+
+  g_object_unref (timeline);
+  g_main_loop_unref (loop);
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_animation_actor_suite (void)
+{
+  Suite *s = suite_create ("HildonAnimationActor");
+
+  TCase *tc1 = tcase_create ("hildon_animation_actor_transaction");
+  tcase_add_checked_fixture (tc1, fx_setup_animation_actor, fx_teardown_animation_actor);
+  tcase_add_test (tc1, test_animation_actor_transaction);
+  tcase_add_test (tc1, test_animation_actor_transaction_pending);
+  suite_add_tcase (s, tc1);
+
+  TCase *tc2 = tcase_create ("hildon_animation_timeline");
+  tcase_add_checked_fixture (tc2, fx_setup_animation_actor, fx_teardown_animation_actor);
+  tcase_add_test (tc2, test_animation_timeline_keyframes);
+  tcase_add_test (tc2, test_animation_timeline_play);
+  tcase_add_test (tc2, test_animation_timeline_loop);
+  suite_add_tcase (s, tc2);
+
+  return s;
+}
@@ -216,6 +216,46 @@ START_TEST (test_show_progress_invalid)
 }
 END_TEST
 
+/* ----- Test case for update_interval -----*/
+/**
+ * Purpose: Check that text updates are collapsed during the update interval
+ * Cases considered:
+ *    - Set the text several times within one interval.
+ *    - Reset the interval, which applies the pending text.
+ */
+START_TEST (test_update_interval_regular)
+{
+  HildonBanner * hildon_banner = NULL;
+  guint n_submitted, n_applied;
+  gchar * text;
+  gint i;
+
+  hildon_banner = HILDON_BANNER(hildon_banner_show_progress(b_window,NULL,TEST_STRING));
+  hildon_banner_set_update_interval(hildon_banner,10000);
+
+  /*Test 1: Only the first text of the interval is applied. */
+  for (i = 0; i < 10; i++) {
+    text = g_strdup_printf("%d%%", i * 10);
+    hildon_banner_set_text(hildon_banner,text);
+    g_free(text);
+  }
+
+  hildon_banner_get_update_stats(hildon_banner,&n_submitted,&n_applied);
+  fail_if(n_submitted != 11 || n_applied != 2,
+          "hildon-banner: updates were not collapsed (%u submitted, %u applied).",
+          n_submitted, n_applied);
+
+  /*Test 2: Resetting the interval applies the last text. */
+  hildon_banner_set_update_interval(hildon_banner,0);
+
+  hildon_banner_get_update_stats(hildon_banner,NULL,&n_applied);
+  fail_if(n_applied != 3,
+          "hildon-banner: pending update was not applied.");
+
+  gtk_widget_destroy(GTK_WIDGET(hildon_banner));
+}
+END_TEST
+
 /* ---------- Suite creation ---------- */
 Suite *create_hildon_banner_suite()
 {
@@ -225,6 +265,7 @@ Suite *create_hildon_banner_suite()
   /* Create test cases */
   TCase *tc1 = tcase_create("show_animation");
   TCase *tc2 = tcase_create("show_progress");
+  TCase *tc3 = tcase_create("update_interval");
 
   /* Create unit tests for hildon_banner_show_animation and add it to the suite */
   tcase_add_checked_fixture(tc1, fx_setup_default_banner, fx_teardown_default_banner);
@@ -238,6 +279,11 @@ Suite *create_hildon_banner_suite()
   tcase_add_test(tc2, test_show_progress_invalid);
   suite_add_tcase (s, tc2);
 
+  /* Create unit tests for hildon_banner_set_update_interval and add it to the suite */
+  tcase_add_checked_fixture(tc3, fx_setup_default_banner, fx_teardown_default_banner);
+  tcase_add_test(tc3, test_update_interval_regular);
+  suite_add_tcase (s, tc3);
+
 
 
   /* Return created suite */
@@ -0,0 +1,316 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+static GtkWindow *window = NULL;
+static GtkBox *box = NULL;
+
+static void
+fx_setup ()
+{
+    int argc = 0;
+
+    gtk_init (&argc, NULL);
+
+    window = GTK_WINDOW (hildon_window_new ());
+
+    fail_if (!HILDON_IS_WINDOW (window),
+             "hildon-button: Window creation failed.");
+
+    box = GTK_BOX (gtk_vbox_new (FALSE, 0));
+    gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (box));
+
+    show_all_test_window (GTK_WIDGET (window));
+}
+
+static void
+fx_teardown ()
+{
+    gtk_widget_destroy (GTK_WIDGET (window));
+}
+
+static HildonButton *
+create_button (HildonButtonArrangement arrangement,
+               gboolean                lightweight)
+{
+    GtkWidget *button;
+
+    button = g_object_new (HILDON_TYPE_BUTTON,
+                           "arrangement", arrangement,
+                           "size", HILDON_SIZE_AUTO,
+                           "title", "Title",
+                           "value", "Value",
+                           "lightweight", lightweight,
+                           NULL);
+
+    gtk_box_pack_start (box, button, FALSE, FALSE, 0);
+    gtk_widget_show (button);
+
+    return HILDON_BUTTON (button);
+}
+
+static gboolean
+is_lightweight (HildonButton *button)
+{
+    gboolean lightweight;
+
+    g_object_get (button, "lightweight", &lightweight, NULL);
+
+    return lightweight;
+}
+
+/**
+   Purpose: test that the title and value of a lightweight button can
+   be set and retrieved like those of a regular button.
+
+   Checks for:
+
+   - Title and value set at construction time.
+   - Title and value set with hildon_button_set_text().
+   - Empty value.
+   - The button stays lightweight.
+*/
+START_TEST (test_lightweight_text)
+{
+    HildonButton *button = create_button (HILDON_BUTTON_ARRANGEMENT_VERTICAL, TRUE);
+
+    fail_if (strcmp (hildon_button_get_title (button), "Title") != 0 ||
+             strcmp (hildon_button_get_value (button), "Value") != 0,
+             "hildon-button: Construction texts are not returned by the lightweight button");
+
+    hildon_button_set_text (button, TEST_STRING, "");
+    fail_if (strcmp (hildon_button_get_title (button), TEST_STRING) != 0,
+             "hildon-button: Title \"%s\" was set, but \"%s\" was retrieved",
+             TEST_STRING, hildon_button_get_title (button));
+    fail_if (strcmp (hildon_button_get_value (button), "") != 0,
+             "hildon-button: Empty value was set, but \"%s\" was retrieved",
+             hildon_button_get_value (button));
+
+    fail_if (!is_lightweight (button),
+             "hildon-button: Setting the text made the button regular");
+}
+END_TEST
+
+/**
+   Purpose: test that a lightweight button requests the same size as an
+   equivalent regular button.
+
+   Checks for:
+
+   - Vertical arrangement.
+   - Horizontal arrangement.
+*/
+START_TEST (test_lightweight_size_request)
+{
+    HildonButtonArrangement arrangements[] = {
+        HILDON_BUTTON_ARRANGEMENT_VERTICAL,
+        HILDON_BUTTON_ARRANGEMENT_HORIZONTAL
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (arrangements); i++) {
+        HildonButton *regular = create_button (arrangements[i], FALSE);
+        HildonButton *lightweight = create_button (arrangements[i], TRUE);
+        GtkRequisition regular_req, lightweight_req;
+
+        gtk_widget_size_request (GTK_WIDGET (regular), &regular_req);
+        gtk_widget_size_request (GTK_WIDGET (lightweight), &lightweight_req);
+
+        fail_if (regular_req.width != lightweight_req.width ||
+                 regular_req.height != lightweight_req.height,
+                 "hildon-button: Arrangement %d: regular button requests %dx%d, "
+                 "lightweight button requests %dx%d", arrangements[i],
+                 regular_req.width, regular_req.height,
+                 lightweight_req.width, lightweight_req.height);
+    }
+}
+END_TEST
+
+/**
+   Purpose: test that a lightweight button turns into a regular one
+   when a feature needs its child widgets, keeping its contents.
+
+   Checks for:
+
+   - Adding the title to a size group.
+   - Setting an image that is not a GtkImage.
+   - Setting an image the button can draw keeps it lightweight.
+*/
+START_TEST (test_lightweight_fallback)
+{
+    HildonButton *button;
+    GtkSizeGroup *group;
+
+    /* Size group */
+    button = create_button (HILDON_BUTTON_ARRANGEMENT_VERTICAL, TRUE);
+    group = gtk_size_group_new (GTK_SIZE_GROUP_HORIZONTAL);
+    hildon_button_add_title_size_group (button, group);
+    g_object_unref (group);
+
+    fail_if (is_lightweight (button),
+             "hildon-button: Button is still lightweight after adding a size group");
+    fail_if (strcmp (hildon_button_get_title (button), "Title") != 0 ||
+             strcmp (hildon_button_get_value (button), "Value") != 0,
+             "hildon-button: Texts were lost when leaving lightweight mode");
+
+    /* Drawable image */
+    button = create_button (HILDON_BUTTON_ARRANGEMENT_VERTICAL, TRUE);
+    hildon_button_set_image (button, gtk_image_new_from_stock (GTK_STOCK_OK,
+                                                               GTK_ICON_SIZE_BUTTON));
+    fail_if (!is_lightweight (button),
+             "hildon-button: A stock image made the button regular");
+
+    /* Image that can't be drawn */
+    hildon_button_set_image (button, gtk_label_new ("Image"));
+    fail_if (is_lightweight (button),
+             "hildon-button: Button is still lightweight after setting a non-image widget");
+    fail_if (strcmp (hildon_button_get_title (button), "Title") != 0,
+             "hildon-button: Title was lost when leaving lightweight mode");
+}
+END_TEST
+
+/**
+   Purpose: test that a lightweight button has an accessible name,
+   although it has no labels.
+
+   Checks for:
+
+   - Name taken from the title.
+   - Name following a change of the title.
+*/
+START_TEST (test_lightweight_accessible_name)
+{
+    HildonButton *button = create_button (HILDON_BUTTON_ARRANGEMENT_VERTICAL, TRUE);
+    AtkObject *accessible = gtk_widget_get_accessible (GTK_WIDGET (button));
+
+    fail_if (g_strcmp0 (atk_object_get_name (accessible), "Title") != 0,
+             "hildon-button: Accessible name is \"%s\" instead of the title",
+             atk_object_get_name (accessible));
+
+    hildon_button_set_title (button, "Other");
+    fail_if (g_strcmp0 (atk_object_get_name (accessible), "Other") != 0,
+             "hildon-button: Accessible name did not follow the title");
+}
+END_TEST
+
+static guint critical_count = 0;
+
+static void
+count_criticals (const gchar    *log_domain,
+                 GLogLevelFlags  log_level,
+                 const gchar    *message,
+                 gpointer        data)
+{
+    critical_count++;
+}
+
+/**
+   Purpose: test that subclasses of a regular button can set the value
+   from their instance init functions, before the labels of the button
+   are created.
+
+   Checks for:
+
+   - No criticals while building a date button and a picker button.
+   - The date button shows the date selected in its selector.
+   - The picker button shows the row selected in its selector.
+*/
+START_TEST (test_regular_subclass_value)
+{
+    HildonTouchSelector *selector;
+    GtkWidget *date_button, *picker_button;
+    gchar *date;
+    guint handler;
+
+    critical_count = 0;
+    handler = g_log_set_handler ("Gtk", G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING,
+                                 count_criticals, NULL);
+
+    /* Date button */
+    date_button = hildon_date_button_new (HILDON_SIZE_AUTO,
+                                          HILDON_BUTTON_ARRANGEMENT_VERTICAL);
+    gtk_box_pack_start (box, date_button, FALSE, FALSE, 0);
+    gtk_widget_show (date_button);
+
+    selector = hildon_picker_button_get_selector (HILDON_PICKER_BUTTON (date_button));
+    date = hildon_touch_selector_get_current_text (selector);
+
+    fail_if (is_lightweight (HILDON_BUTTON (date_button)),
+             "hildon-button: The date button should be a regular button");
+    fail_if (gtk_bin_get_child (GTK_BIN (date_button)) == NULL,
+             "hildon-button: The date button has no labels");
+    fail_if (date == NULL || date[0] == '\0' ||
+             strcmp (hildon_button_get_value (HILDON_BUTTON (date_button)), date) != 0,
+             "hildon-button: The date button shows \"%s\" instead of the date \"%s\"",
+             hildon_button_get_value (HILDON_BUTTON (date_button)), date);
+    g_free (date);
+
+    /* Picker button */
+    picker_button = hildon_picker_button_new (HILDON_SIZE_AUTO,
+                                              HILDON_BUTTON_ARRANGEMENT_HORIZONTAL);
+    selector = HILDON_TOUCH_SELECTOR (hildon_touch_selector_new_text ());
+    hildon_touch_selector_append_text (selector, "First");
+    hildon_touch_selector_append_text (selector, "Second");
+    hildon_picker_button_set_selector (HILDON_PICKER_BUTTON (picker_button), selector);
+    hildon_button_set_title (HILDON_BUTTON (picker_button), "Title");
+    hildon_picker_button_set_active (HILDON_PICKER_BUTTON (picker_button), 1);
+    gtk_box_pack_start (box, picker_button, FALSE, FALSE, 0);
+    gtk_widget_show (picker_button);
+
+    fail_if (strcmp (hildon_button_get_value (HILDON_BUTTON (picker_button)), "Second") != 0,
+             "hildon-button: The picker button shows \"%s\" instead of \"Second\"",
+             hildon_button_get_value (HILDON_BUTTON (picker_button)));
+
+    g_log_remove_handler ("Gtk", handler);
+
+    fail_if (critical_count != 0,
+             "hildon-button: %u criticals or warnings while building the buttons",
+             critical_count);
+}
+END_TEST
+
+Suite *create_hildon_button_suite (void)
+{
+    Suite *s = suite_create ("HildonButton");
+
+    TCase *tc1 = tcase_create ("hildon_button_lightweight");
+    tcase_add_checked_fixture (tc1, fx_setup, fx_teardown);
+    tcase_add_test (tc1, test_lightweight_text);
+    tcase_add_test (tc1, test_lightweight_size_request);
+    tcase_add_test (tc1, test_lightweight_fallback);
+    tcase_add_test (tc1, test_lightweight_accessible_name);
+    suite_add_tcase (s, tc1);
+
+    TCase *tc2 = tcase_create ("hildon_button_regular");
+    tcase_add_checked_fixture (tc2, fx_setup, fx_teardown);
+    tcase_add_test (tc2, test_regular_subclass_value);
+    suite_add_tcase (s, tc2);
+
+    return s;
+}
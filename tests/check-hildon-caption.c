@@ -32,6 +32,7 @@
 #include "test_suites.h"
 #include "check_utils.h"
 #include <hildon/hildon-caption.h>
+#include <hildon/hildon-size-group.h>
 
 #include <gtk/gtkvbox.h>
 #include <hildon/hildon-window.h>
@@ -421,6 +422,126 @@ START_TEST (test_get_label_invalid)
 }
 END_TEST
 
+/* ----- Test case for size_group -----*/
+
+/**
+ * Purpose: test aligning captions with a HildonSizeGroup
+ * Cases considered:
+ *    - the group requests the width of its widest member
+ *    - the group grows when a narrower member becomes the widest one
+ *    - the group shrinks back when that member is destroyed
+ */
+START_TEST (test_size_group_regular)
+{
+  GtkSizeGroup *group = NULL;
+  GtkWidget *window = NULL, *vbox = NULL, *short_caption = NULL, *long_caption = NULL;
+  gint width, new_width;
+  int argc = 0;
+
+  gtk_init (&argc, NULL);
+
+  group = hildon_size_group_new ();
+  window = create_test_window ();
+  vbox = gtk_vbox_new (FALSE, 0);
+  gtk_container_add (GTK_CONTAINER (window), vbox);
+
+  short_caption = hildon_caption_new (group, "A", gtk_entry_new (), NULL,
+                                      HILDON_CAPTION_OPTIONAL);
+  long_caption = hildon_caption_new (group, "A much longer caption", gtk_entry_new (), NULL,
+                                     HILDON_CAPTION_OPTIONAL);
+  gtk_box_pack_start (GTK_BOX (vbox), short_caption, FALSE, FALSE, 0);
+  gtk_box_pack_start (GTK_BOX (vbox), long_caption, FALSE, FALSE, 0);
+  show_all_test_window (window);
+
+  /* Test 1 */
+  width = hildon_size_group_get_width (HILDON_SIZE_GROUP (group));
+  fail_if (width <= 0,
+           "hildon-caption: the size group width is %d and should be positive", width);
+
+  /* Test 2 */
+  hildon_caption_set_label (HILDON_CAPTION (short_caption),
+                            "An even much longer caption than the other one");
+  show_all_test_window (window);
+  fail_if (hildon_size_group_get_width (HILDON_SIZE_GROUP (group)) <= width,
+           "hildon-caption: the size group did not grow with its widest member");
+
+  /* Test 3 */
+  gtk_widget_destroy (short_caption);
+  show_all_test_window (window);
+  new_width = hildon_size_group_get_width (HILDON_SIZE_GROUP (group));
+  fail_if (new_width != width,
+           "hildon-caption: the size group width is %d and should be %d", new_width, width);
+
+  gtk_widget_destroy (window);
+  g_object_unref (group);
+}
+END_TEST
+
+static GtkWidget *
+pack_size_group_label (GtkSizeGroup *group, GtkWidget *vbox, const gchar *text)
+{
+  GtkWidget *hbox = gtk_hbox_new (FALSE, 0);
+  GtkWidget *label = gtk_label_new (text);
+
+  gtk_box_pack_start (GTK_BOX (hbox), label, FALSE, FALSE, 0);
+  gtk_box_pack_start (GTK_BOX (vbox), hbox, FALSE, FALSE, 0);
+  hildon_size_group_add_widget (HILDON_SIZE_GROUP (group), label);
+
+  return label;
+}
+
+/**
+ * Purpose: test that the members of a HildonSizeGroup are allocated the
+ * width of the group, and not only requested it
+ * Cases considered:
+ *    - every member is allocated the width of the widest one
+ *    - the other members are allocated the new width when a narrower
+ *      member becomes the widest one
+ */
+START_TEST (test_size_group_allocation)
+{
+  GtkSizeGroup *group = NULL;
+  GtkWidget *window = NULL, *vbox = NULL, *labels[3];
+  gint width, old_width;
+  guint i;
+  int argc = 0;
+
+  gtk_init (&argc, NULL);
+
+  group = hildon_size_group_new ();
+  window = create_test_window ();
+  vbox = gtk_vbox_new (FALSE, 0);
+  gtk_container_add (GTK_CONTAINER (window), vbox);
+
+  labels[0] = pack_size_group_label (group, vbox, "A");
+  labels[1] = pack_size_group_label (group, vbox, "A longer label");
+  labels[2] = pack_size_group_label (group, vbox, "AB");
+  show_all_test_window (window);
+
+  /* Test 1 */
+  width = hildon_size_group_get_width (HILDON_SIZE_GROUP (group));
+  for (i = 0; i < G_N_ELEMENTS (labels); i++)
+    fail_if (labels[i]->allocation.width != width,
+             "hildon-caption: member %d is allocated width %d instead of %d",
+             i, labels[i]->allocation.width, width);
+
+  /* Test 2 */
+  gtk_label_set_text (GTK_LABEL (labels[0]), "A label longer than all the others");
+  old_width = width;
+  show_all_test_window (window);
+  width = hildon_size_group_get_width (HILDON_SIZE_GROUP (group));
+  fail_if (width <= old_width,
+           "hildon-caption: the size group did not grow with its widest member");
+  for (i = 0; i < G_N_ELEMENTS (labels); i++)
+    fail_if (labels[i]->allocation.width != width,
+             "hildon-caption: after growing, member %d is allocated width %d instead of %d",
+             i, labels[i]->allocation.width, width);
+
+  gtk_widget_destroy (window);
+  g_object_unref (group);
+}
+END_TEST
+
 /* ---------- Suite creation ---------- */
 
 Suite *create_hildon_caption_suite()
@@ -434,6 +555,7 @@ Suite *create_hildon_caption_suite()
   TCase *tc3 = tcase_create("get_status");
   TCase *tc4 = tcase_create("set_label");
   TCase *tc5 = tcase_create("get_label");
+  TCase *tc6 = tcase_create("size_group");
 
   /* Create test case for is_mandatory and add it to the suite */
   tcase_add_checked_fixture(tc1, fx_setup_default_caption, fx_teardown_default_caption);
@@ -465,6 +587,11 @@ Suite *create_hildon_caption_suite()
   tcase_add_test(tc5, test_get_label_invalid);
   suite_add_tcase (s, tc5);
 
+  /* Create test case for size_group and add it to the suite */
+  tcase_add_test(tc6, test_size_group_regular);
+  tcase_add_test(tc6, test_size_group_allocation);
+  suite_add_tcase (s, tc6);
+
   /* Return created suite */
   return s;             
 }
@@ -255,6 +255,41 @@ START_TEST (test_set_color_invalid)
 }
 END_TEST
 
+/* ----- Test case for get_frame_stats -----*/
+
+/**
+ * Purpose: Check that color updates done within one frame are coalesced
+ * Cases considered:
+ *    - Set three different colors in a row, only the first is drawn at once
+ *      and the other two are merged into a single pending frame.
+ *    - Get stats from NULL object.
+ */
+START_TEST (test_get_frame_stats_coalesced)
+{
+  GdkColor color;
+  guint rendered, coalesced, dropped;
+
+  gdk_color_parse ("#FF0000", &color);
+  hildon_color_chooser_set_color (color_chooser, &color);
+  gdk_color_parse ("#00FF00", &color);
+  hildon_color_chooser_set_color (color_chooser, &color);
+  gdk_color_parse ("#0000FF", &color);
+  hildon_color_chooser_set_color (color_chooser, &color);
+
+  hildon_color_chooser_get_frame_stats (color_chooser, &rendered, &coalesced, &dropped);
+
+  fail_if (rendered != 1,
+           "hildon-color-chooser: %u frames were drawn immediately and should be 1",
+           rendered);
+  fail_if (coalesced != 1,
+           "hildon-color-chooser: %u updates were coalesced and should be 1",
+           coalesced);
+
+  /* Test 2: Get stats from NULL object */
+  hildon_color_chooser_get_frame_stats (NULL, &rendered, &coalesced, &dropped);
+}
+END_TEST
+
 
 /* ---------- Suite creation ---------- */
 
@@ -271,6 +306,12 @@ Suite *create_hildon_color_chooser_suite()
   tcase_add_test(tc1, test_set_color_invalid);
   suite_add_tcase (s, tc1);
 
+  /* Create test case for hildon_color_chooser_get_frame_stats and add it to the suite */
+  TCase *tc2 = tcase_create("get_frame_stats");
+  tcase_add_checked_fixture(tc2, fx_setup_default_color_chooser, fx_teardown_default_color_chooser);
+  tcase_add_test(tc2, test_get_frame_stats_coalesced);
+  suite_add_tcase (s, tc2);
+
   /* Return created suite */
   return s;             
 }
@@ -28,6 +28,7 @@
 #include "test_suites.h"
 #include "check_utils.h"
 #include <string.h>
+#include <gio/gio.h>
 
 #include <hildon/hildon-find-toolbar.h>
 #include <hildon/hildon-window.h>
@@ -160,6 +161,194 @@ START_TEST (test_set_get_property_label_invalid)
 }
 END_TEST
 
+/* ----- Test case for the search history -----*/
+
+static void
+append_to_history (const gchar *prefix)
+{
+  gboolean handled;
+
+  g_object_set (find_toolbar, "prefix", prefix, NULL);
+  g_signal_emit_by_name (find_toolbar, "history_append", &handled);
+}
+
+/**
+ * Purpose: Check that the history of a toolbar without a list keeps
+ *          only the last "history-limit" different entries.
+ * Cases considered:
+ *    - Append more entries than the limit, with a duplicate
+ *    - Get the "list" property and check its rows
+ *    - Search again after getting the "list" property: the list follows
+ *    - Clear the list: the toolbar keeps the history in it
+ */
+START_TEST (test_history_append_regular)
+{
+  GtkListStore *list = NULL;
+  GtkTreeIter iter;
+  gchar *first = NULL;
+  gchar *last = NULL;
+
+  g_object_set (find_toolbar, "history-limit", 2, NULL);
+
+  /* Test1: "a" is moved to the end and "b" falls out of the history */
+  append_to_history ("a");
+  append_to_history ("b");
+  append_to_history ("a");
+  append_to_history ("c");
+  fail_if (hildon_find_toolbar_get_last_index (find_toolbar) != 1,
+           "hildon-find-toolbar: History should have 2 entries, last index is %d",
+           hildon_find_toolbar_get_last_index (find_toolbar));
+
+  /* Test2: the list keeps the entries, oldest first */
+  g_object_get (find_toolbar, "list", &list, NULL);
+  fail_if (!GTK_IS_LIST_STORE (list),
+           "hildon-find-toolbar: Property \"list\" is not a GtkListStore");
+  fail_if (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (list), NULL) != 2,
+           "hildon-find-toolbar: History list should have 2 rows");
+
+  gtk_tree_model_get_iter_first (GTK_TREE_MODEL (list), &iter);
+  gtk_tree_model_get (GTK_TREE_MODEL (list), &iter, 0, &first, -1);
+  gtk_tree_model_iter_next (GTK_TREE_MODEL (list), &iter);
+  gtk_tree_model_get (GTK_TREE_MODEL (list), &iter, 0, &last, -1);
+  fail_if (strcmp (first, "a") != 0 || strcmp (last, "c") != 0,
+           "hildon-find-toolbar: History list is \"%s\", \"%s\" instead of \"a\", \"c\"",
+           first, last);
+
+  g_free (first);
+  g_free (last);
+
+  /* Test3: the list follows later searches */
+  append_to_history ("d");
+  fail_if (hildon_find_toolbar_get_last_index (find_toolbar) != 1,
+           "hildon-find-toolbar: History should still have 2 entries, last index is %d",
+           hildon_find_toolbar_get_last_index (find_toolbar));
+  fail_if (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (list), NULL) != 2,
+           "hildon-find-toolbar: History list should still have 2 rows");
+
+  gtk_tree_model_get_iter_first (GTK_TREE_MODEL (list), &iter);
+  gtk_tree_model_get (GTK_TREE_MODEL (list), &iter, 0, &first, -1);
+  gtk_tree_model_iter_next (GTK_TREE_MODEL (list), &iter);
+  gtk_tree_model_get (GTK_TREE_MODEL (list), &iter, 0, &last, -1);
+  fail_if (strcmp (first, "c") != 0 || strcmp (last, "d") != 0,
+           "hildon-find-toolbar: History list is \"%s\", \"%s\" instead of \"c\", \"d\"",
+           first, last);
+
+  g_free (first);
+  g_free (last);
+
+  /* Test4: changes to the list change the history */
+  gtk_list_store_clear (list);
+  append_to_history ("e");
+  fail_if (gtk_tree_model_iter_n_children (GTK_TREE_MODEL (list), NULL) != 1,
+           "hildon-find-toolbar: History list should only have the new entry");
+  fail_if (hildon_find_toolbar_get_last_index (find_toolbar) != 0,
+           "hildon-find-toolbar: History should have 1 entry, last index is %d",
+           hildon_find_toolbar_get_last_index (find_toolbar));
+
+  g_object_unref (list);
+}
+END_TEST
+
+/**
+ * Purpose: Check that the history of a toolbar without a list accepts
+ *          any valid "history-limit".
+ * Cases considered:
+ *    - Set the largest limit and append entries
+ *    - Lower the limit below the number of entries
+ */
+START_TEST (test_history_append_limit)
+{
+  gchar prefix[16];
+  gint i;
+
+  /* Test1: no slots are allocated for the entries that are not there */
+  g_object_set (find_toolbar, "history-limit", G_MAXINT, NULL);
+  for (i = 0; i < 20; i++) {
+    g_snprintf (prefix, sizeof (prefix), "entry %d", i);
+    append_to_history (prefix);
+  }
+  fail_if (hildon_find_toolbar_get_last_index (find_toolbar) != 19,
+           "hildon-find-toolbar: History should have 20 entries, last index is %d",
+           hildon_find_toolbar_get_last_index (find_toolbar));
+
+  /* Test2: the oldest entries are dropped */
+  g_object_set (find_toolbar, "history-limit", 3, NULL);
+  fail_if (hildon_find_toolbar_get_last_index (find_toolbar) != 2,
+           "hildon-find-toolbar: History should have 3 entries, last index is %d",
+           hildon_find_toolbar_get_last_index (find_toolbar));
+}
+END_TEST
+
+/* ----- Test case for incremental search -----*/
+
+static gint incremental_searches = 0;
+static gboolean incremental_refine = FALSE;
+static GCancellable *incremental_cancellable = NULL;
+
+static void
+on_incremental_search (HildonFindToolbar *toolbar,
+                       const gchar *prefix,
+                       gboolean refine,
+                       GCancellable *cancellable,
+                       gpointer data)
+{
+  incremental_searches++;
+  incremental_refine = refine;
+
+  if (incremental_cancellable != NULL)
+    g_object_unref (incremental_cancellable);
+  incremental_cancellable = g_object_ref (cancellable);
+}
+
+static void
+type_prefix (const gchar *prefix)
+{
+  g_object_set (find_toolbar, "prefix", prefix, NULL);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+}
+
+/**
+ * Purpose: Check that "incremental-search" is emitted while typing.
+ * Cases considered:
+ *    - Search for a prefix
+ *    - Search for a longer prefix, refining the previous one
+ *    - Search for an unrelated prefix, cancelling the previous one
+ */
+START_TEST (test_incremental_search_regular)
+{
+  GCancellable *previous;
+
+  g_object_set (find_toolbar, "incremental", TRUE, "incremental-delay", 0, NULL);
+  g_signal_connect (find_toolbar, "incremental-search",
+                    G_CALLBACK (on_incremental_search), NULL);
+
+  /* Test1: first search is not a refinement */
+  type_prefix ("ab");
+  fail_if (incremental_searches != 1 || incremental_refine,
+           "hildon-find-toolbar: First incremental search was not emitted properly");
+
+  /* Test2: a longer prefix refines the previous search */
+  type_prefix ("abc");
+  fail_if (incremental_searches != 2 || !incremental_refine,
+           "hildon-find-toolbar: Longer prefix was not searched as a refinement");
+
+  /* Test3: a different prefix cancels the running search */
+  previous = g_object_ref (incremental_cancellable);
+  type_prefix ("x");
+  fail_if (incremental_searches != 3 || incremental_refine,
+           "hildon-find-toolbar: Unrelated prefix was searched as a refinement");
+  fail_if (!g_cancellable_is_cancelled (previous),
+           "hildon-find-toolbar: Previous incremental search was not cancelled");
+
+  g_object_unref (previous);
+  g_object_unref (incremental_cancellable);
+  incremental_cancellable = NULL;
+  incremental_searches = 0;
+}
+END_TEST
+
 /* ---------- Suite creation ---------- */
 
 Suite *create_hildon_find_toolbar_suite()
@@ -170,6 +359,8 @@ Suite *create_hildon_find_toolbar_suite()
   /* Create test cases */
   TCase *tc1 = tcase_create("set_get_property_label");
   TCase *tc2 = tcase_create("model_set_get_property_label");
+  TCase *tc3 = tcase_create("history_append");
+  TCase *tc4 = tcase_create("incremental_search");
 
   /* Create unit tests for set/get of property "label" and add it to the suite */
   tcase_add_checked_fixture(tc1, fx_setup_default_find_toolbar, fx_teardown_find_toolbar);
@@ -183,6 +374,17 @@ Suite *create_hildon_find_toolbar_suite()
   tcase_add_test(tc2, test_set_get_property_label_invalid);
   suite_add_tcase (s, tc2);
 
+  /* Create unit tests for the search history and add it to the suite */
+  tcase_add_checked_fixture(tc3, fx_setup_default_find_toolbar, fx_teardown_find_toolbar);
+  tcase_add_test(tc3, test_history_append_regular);
+  tcase_add_test(tc3, test_history_append_limit);
+  suite_add_tcase (s, tc3);
+
+  /* Create unit tests for incremental search and add it to the suite */
+  tcase_add_checked_fixture(tc4, fx_setup_default_find_toolbar, fx_teardown_find_toolbar);
+  tcase_add_test(tc4, test_incremental_search_regular);
+  suite_add_tcase (s, tc4);
+
   /* Return created suite */
   return s;
 }
@@ -0,0 +1,232 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+static GtkWidget *dialog = NULL;
+static HildonTouchSelector *selector = NULL;
+
+static GtkListStore *
+create_store (void)
+{
+  GtkListStore *store;
+  GtkTreeIter iter;
+
+  store = gtk_list_store_new (1, G_TYPE_STRING);
+  gtk_list_store_insert_with_values (store, &iter, -1, 0, "Row one", -1);
+  gtk_list_store_insert_with_values (store, &iter, -1, 0, "Row two", -1);
+  gtk_list_store_insert_with_values (store, &iter, -1, 0, "Row three", -1);
+  gtk_list_store_insert_with_values (store, &iter, -1, 0, "Row four", -1);
+
+  return store;
+}
+
+static void
+fx_setup_picker_dialog ()
+{
+  int argc = 0;
+
+  gtk_init (&argc, NULL);
+
+  dialog = hildon_picker_dialog_new (NULL);
+  fail_if (!HILDON_IS_PICKER_DIALOG (dialog),
+           "hildon-picker-dialog: Creation failed.");
+
+  selector = HILDON_TOUCH_SELECTOR (hildon_touch_selector_new ());
+}
+
+static void
+fx_teardown_picker_dialog ()
+{
+  gtk_widget_destroy (dialog);
+}
+
+/* Shows the dialog, which saves the current selection */
+static void
+show_dialog (void)
+{
+  gtk_widget_show (dialog);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+}
+
+/* Cancels the dialog, which restores the saved selection */
+static void
+cancel_dialog (void)
+{
+  gtk_dialog_response (GTK_DIALOG (dialog), GTK_RESPONSE_DELETE_EVENT);
+  gtk_widget_hide (dialog);
+}
+
+static void
+select_row (gint column, gint row)
+{
+  GtkTreeModel *model;
+  GtkTreeIter iter;
+
+  model = hildon_touch_selector_get_model (selector, column);
+  gtk_tree_model_iter_nth_child (model, &iter, NULL, row);
+  hildon_touch_selector_select_iter (selector, column, &iter, FALSE);
+}
+
+/* Returns the selected rows of @column as a bitmask */
+static guint
+get_selected_mask (gint column)
+{
+  GList *rows, *l;
+  guint mask = 0;
+
+  rows = hildon_touch_selector_get_selected_rows (selector, column);
+  for (l = rows; l; l = l->next) {
+    mask |= 1 << gtk_tree_path_get_indices (l->data)[0];
+    gtk_tree_path_free (l->data);
+  }
+  g_list_free (rows);
+
+  return mask;
+}
+
+/**
+ * Purpose: Check that cancelling the dialog restores the selection of a
+ *          selector with several single selection columns
+ * Cases considered:
+ *    - Change the selection and append a row to the model while the
+ *      dialog is shown, then cancel it.
+ *    - Prepend a row to the model while the dialog is hidden, so the
+ *      selected row moves, then show the dialog again, change the
+ *      selection and cancel it.
+ */
+START_TEST (test_picker_dialog_restore_single)
+{
+  GtkListStore *first, *second;
+  GtkTreeIter iter;
+
+  first = create_store ();
+  second = create_store ();
+  hildon_touch_selector_append_text_column (selector, GTK_TREE_MODEL (first), TRUE);
+  hildon_touch_selector_append_text_column (selector, GTK_TREE_MODEL (second), TRUE);
+  g_object_unref (first);
+  g_object_unref (second);
+
+  hildon_touch_selector_set_active (selector, 0, 1);
+  hildon_touch_selector_set_active (selector, 1, 2);
+  hildon_picker_dialog_set_selector (HILDON_PICKER_DIALOG (dialog), selector);
+
+  /* Test 1: model changes while the dialog is shown */
+  show_dialog ();
+  hildon_touch_selector_set_active (selector, 0, 3);
+  gtk_list_store_insert_with_values (first, &iter, -1, 0, "Row five", -1);
+  cancel_dialog ();
+
+  fail_if (hildon_touch_selector_get_active (selector, 0) != 1,
+           "hildon-picker-dialog: First column was not restored after cancelling");
+  fail_if (hildon_touch_selector_get_active (selector, 1) != 2,
+           "hildon-picker-dialog: Second column changed after cancelling");
+
+  /* Test 2: model changes while the dialog is hidden */
+  gtk_list_store_insert_with_values (first, &iter, 0, 0, "Row zero", -1);
+  fail_if (hildon_touch_selector_get_active (selector, 0) != 2,
+           "hildon-picker-dialog: Selected row did not follow the model");
+
+  show_dialog ();
+  hildon_touch_selector_set_active (selector, 0, 0);
+  cancel_dialog ();
+
+  fail_if (hildon_touch_selector_get_active (selector, 0) != 2,
+           "hildon-picker-dialog: Selection restored from a stale snapshot");
+}
+END_TEST
+
+/**
+ * Purpose: Check that cancelling the dialog restores the selection of a
+ *          multiple selection column
+ * Cases considered:
+ *    - Change the selection and append a row to the model while the
+ *      dialog is shown, then cancel it.
+ *    - Prepend a row to the model while the dialog is hidden, so the
+ *      selected rows move, then show the dialog again, change the
+ *      selection and cancel it.
+ */
+START_TEST (test_picker_dialog_restore_multiple)
+{
+  GtkListStore *store;
+  GtkTreeIter iter;
+  guint mask;
+
+  store = create_store ();
+  hildon_touch_selector_append_text_column (selector, GTK_TREE_MODEL (store), TRUE);
+  g_object_unref (store);
+
+  hildon_touch_selector_set_column_selection_mode (selector,
+                                                   HILDON_TOUCH_SELECTOR_SELECTION_MODE_MULTIPLE);
+  hildon_touch_selector_unselect_all (selector, 0);
+  select_row (0, 0);
+  select_row (0, 2);
+  hildon_picker_dialog_set_selector (HILDON_PICKER_DIALOG (dialog), selector);
+
+  /* Test 1: model changes while the dialog is shown */
+  show_dialog ();
+  hildon_touch_selector_unselect_all (selector, 0);
+  select_row (0, 1);
+  gtk_list_store_insert_with_values (store, &iter, -1, 0, "Row five", -1);
+  cancel_dialog ();
+
+  mask = get_selected_mask (0);
+  fail_if (mask != ((1 << 0) | (1 << 2)),
+           "hildon-picker-dialog: Selection was not restored after cancelling (0x%x)",
+           mask);
+
+  /* Test 2: model changes while the dialog is hidden */
+  gtk_list_store_insert_with_values (store, &iter, 0, 0, "Row zero", -1);
+
+  show_dialog ();
+  hildon_touch_selector_unselect_all (selector, 0);
+  select_row (0, 0);
+  cancel_dialog ();
+
+  mask = get_selected_mask (0);
+  fail_if (mask != ((1 << 1) | (1 << 3)),
+           "hildon-picker-dialog: Selection restored from a stale snapshot (0x%x)",
+           mask);
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_picker_dialog_suite (void)
+{
+  Suite *s = suite_create ("HildonPickerDialog");
+
+  TCase *tc1 = tcase_create ("hildon_picker_dialog_restore");
+  tcase_add_checked_fixture (tc1, fx_setup_picker_dialog, fx_teardown_picker_dialog);
+  tcase_add_test (tc1, test_picker_dialog_restore_single);
+  tcase_add_test (tc1, test_picker_dialog_restore_multiple);
+  suite_add_tcase (s, tc1);
+
+  return s;
+}
@@ -0,0 +1,212 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include <gdk/gdkx.h>
+#include <X11/Xatom.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+#include <hildon/hildon-remote-texture.h>
+
+static GtkWidget *window = NULL;
+static HildonRemoteTexture *texture = NULL;
+
+static void
+process_events (void)
+{
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+}
+
+/* Does what hildon-desktop does once it has created the texture actor */
+static void
+set_texture_ready (void)
+{
+  GtkWidget *widget = GTK_WIDGET (texture);
+  Display *display = GDK_WINDOW_XDISPLAY (widget->window);
+  Atom ready = XInternAtom (display, "_HILDON_TEXTURE_CLIENT_READY", False);
+
+  XChangeProperty (display, GDK_WINDOW_XID (widget->window), ready,
+                   XA_ATOM, 32, PropModeReplace,
+                   (unsigned char *) &ready, 1);
+  XSync (display, False);
+
+  process_events ();
+}
+
+static guint
+get_submitted (void)
+{
+  guint submitted;
+
+  hildon_remote_texture_get_damage_stats (texture, &submitted, NULL);
+
+  return submitted;
+}
+
+static guint
+get_sent (void)
+{
+  guint sent;
+
+  hildon_remote_texture_get_damage_stats (texture, NULL, &sent);
+
+  return sent;
+}
+
+static void
+fx_setup_remote_texture ()
+{
+  int argc = 0;
+
+  gtk_init (&argc, NULL);
+
+  window = hildon_window_new ();
+  show_test_window (window);
+
+  texture = HILDON_REMOTE_TEXTURE (hildon_remote_texture_new ());
+  fail_if (!HILDON_IS_REMOTE_TEXTURE (texture),
+           "hildon-remote-texture: Creation failed.");
+
+  hildon_remote_texture_set_parent (texture, GTK_WINDOW (window));
+  gtk_widget_show (GTK_WIDGET (texture));
+  process_events ();
+}
+
+static void
+fx_teardown_remote_texture ()
+{
+  gtk_widget_destroy (GTK_WIDGET (texture));
+  gtk_widget_destroy (window);
+}
+
+/**
+ * Purpose: Check that damage is queued until hildon-desktop is ready
+ * Cases considered:
+ *    - Damage areas before the texture is ready, flushing them explicitly.
+ *    - Make the texture ready.
+ *    - Damage an empty area.
+ */
+START_TEST (test_remote_texture_damage_pending)
+{
+  hildon_remote_texture_update_area (texture, 0, 0, 10, 10);
+  hildon_remote_texture_update_area (texture, 10, 0, 10, 10);
+  hildon_remote_texture_update_area (texture, 5, 5, 10, 10);
+  hildon_remote_texture_commit_damage (texture);
+  process_events ();
+
+  fail_if (get_submitted () != 3,
+           "hildon-remote-texture: %u damaged areas counted instead of 3",
+           get_submitted ());
+  fail_if (get_sent () != 0,
+           "hildon-remote-texture: Damage sent before the texture was ready");
+
+  /* The queued damage is merged into its bounding box */
+  set_texture_ready ();
+  fail_if (get_sent () != 1,
+           "hildon-remote-texture: %u damage messages sent for queued damage instead of 1",
+           get_sent ());
+
+  hildon_remote_texture_update_area (texture, 0, 0, 0, 10);
+  hildon_remote_texture_update_area (texture, 0, 0, 10, -1);
+  process_events ();
+  fail_if (get_submitted () != 3 || get_sent () != 1,
+           "hildon-remote-texture: Empty areas were taken as damage");
+}
+END_TEST
+
+/**
+ * Purpose: Check that damage is accumulated before it is sent
+ * Cases considered:
+ *    - Damage adjacent areas, then commit them.
+ *    - Damage areas far apart from each other, then commit them.
+ *    - Damage areas and let the main loop send them.
+ *    - Commit without any damage.
+ */
+START_TEST (test_remote_texture_damage_accumulate)
+{
+  guint sent;
+  gint i;
+
+  set_texture_ready ();
+  sent = get_sent ();
+
+  /* Test 1: adjacent areas are sent as one rectangle */
+  for (i = 0; i < 4; i++)
+    hildon_remote_texture_update_area (texture, i * 10, 0, 10, 10);
+  hildon_remote_texture_commit_damage (texture);
+
+  fail_if (get_sent () != sent + 1,
+           "hildon-remote-texture: %u damage messages sent for adjacent areas instead of 1",
+           get_sent () - sent);
+  sent = get_sent ();
+
+  /* Test 2: merging areas far apart would update too much */
+  hildon_remote_texture_update_area (texture, 0, 0, 10, 10);
+  hildon_remote_texture_update_area (texture, 100, 100, 10, 10);
+  hildon_remote_texture_commit_damage (texture);
+
+  fail_if (get_sent () != sent + 2,
+           "hildon-remote-texture: %u damage messages sent for distant areas instead of 2",
+           get_sent () - sent);
+  sent = get_sent ();
+
+  /* Test 3: damage is sent once the main loop is idle */
+  hildon_remote_texture_update_area (texture, 0, 0, 10, 10);
+  hildon_remote_texture_update_area (texture, 0, 10, 10, 10);
+  fail_if (get_sent () != sent,
+           "hildon-remote-texture: Damage sent before the end of the iteration");
+
+  process_events ();
+  fail_if (get_sent () != sent + 1,
+           "hildon-remote-texture: %u damage messages sent by the main loop instead of 1",
+           get_sent () - sent);
+  sent = get_sent ();
+
+  /* Test 4: nothing to commit */
+  hildon_remote_texture_commit_damage (texture);
+  fail_if (get_sent () != sent,
+           "hildon-remote-texture: Damage sent without damaged areas");
+
+  fail_if (get_submitted () != 8,
+           "hildon-remote-texture: %u damaged areas counted instead of 8",
+           get_submitted ());
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_remote_texture_suite (void)
+{
+  Suite *s = suite_create ("HildonRemoteTexture");
+
+  TCase *tc1 = tcase_create ("hildon_remote_texture_damage");
+  tcase_add_checked_fixture (tc1, fx_setup_remote_texture, fx_teardown_remote_texture);
+  tcase_add_test (tc1, test_remote_texture_damage_pending);
+  tcase_add_test (tc1, test_remote_texture_damage_accumulate);
+  suite_add_tcase (s, tc1);
+
+  return s;
+}
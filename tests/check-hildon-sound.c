@@ -0,0 +1,150 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include "test_suites.h"
+#include <hildon/hildon-sound.h>
+
+/* -------------------- Fixtures -------------------- */
+
+static gchar *samples[3] = { NULL, NULL, NULL };
+
+/* Writes a short silent 8 kHz, 16 bit mono WAV file */
+static gchar *
+write_sample (void)
+{
+  static const guchar header[] = {
+    'R', 'I', 'F', 'F', 0x44, 0x06, 0, 0, 'W', 'A', 'V', 'E',
+    'f', 'm', 't', ' ', 16, 0, 0, 0, 1, 0, 1, 0,
+    0x40, 0x1f, 0, 0, 0x80, 0x3e, 0, 0, 2, 0, 16, 0,
+    'd', 'a', 't', 'a', 0x20, 0x06, 0, 0
+  };
+  guchar data[sizeof (header) + 0x620] = { 0 };
+  gchar *filename = NULL;
+  gint fd;
+
+  memcpy (data, header, sizeof (header));
+
+  fd = g_file_open_tmp ("hildon-sound-XXXXXX.wav", &filename, NULL);
+  fail_if (fd < 0, "hildon-sound: Could not create a sample file");
+  fail_if (write (fd, data, sizeof (data)) != sizeof (data),
+           "hildon-sound: Could not write a sample file");
+  close (fd);
+
+  return filename;
+}
+
+static void
+fx_setup_samples ()
+{
+  int argc = 0;
+  guint i;
+
+  gtk_init(&argc, NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (samples); i++)
+    samples[i] = write_sample ();
+}
+
+static void
+fx_teardown_samples ()
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (samples); i++) {
+    g_unlink (samples[i]);
+    g_free (samples[i]);
+    samples[i] = NULL;
+  }
+}
+
+/* -------------------- Test cases -------------------- */
+
+/* ----- Test case for hildon_sound_cache_sample -----*/
+
+/**
+ * Purpose: Check that cached samples are played from the cache of the
+ * sound server, and the others are not. Needs a running sound server.
+ * Cases considered:
+ *    - Cache two different files and play them
+ *    - Cache the same file again
+ *    - Play a file that was not cached
+ */
+START_TEST (test_sound_cache_sample_regular)
+{
+  /* Test 1 */
+  fail_if (!hildon_sound_cache_sample (samples[0]) ||
+           !hildon_sound_cache_sample (samples[1]),
+           "hildon-sound: Sound files could not be cached");
+  fail_if (!hildon_sound_play_sample (samples[0]) ||
+           !hildon_sound_play_sample (samples[1]),
+           "hildon-sound: Cached sound files were not played from the cache");
+
+  /* Test 2 */
+  fail_if (!hildon_sound_cache_sample (samples[0]),
+           "hildon-sound: Caching a sound file twice failed");
+
+  /* Test 3 */
+  fail_if (hildon_sound_play_sample (samples[2]),
+           "hildon-sound: A sound file that was not cached was played from the cache");
+}
+END_TEST
+
+/**
+ * Purpose: Check that samples that can't be cached are not reported as
+ * played from the cache
+ * Cases considered:
+ *    - Cache and play a file that does not exist
+ */
+START_TEST (test_sound_cache_sample_invalid)
+{
+  /* Test 1 */
+  fail_if (hildon_sound_cache_sample ("file_that_does_not_exist.wav"),
+           "hildon-sound: A sound file that does not exist was cached");
+  fail_if (hildon_sound_play_sample ("file_that_does_not_exist.wav"),
+           "hildon-sound: A sound file that does not exist was played from the cache");
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_sound_suite()
+{
+  /* Create the suite */
+  Suite *s = suite_create("HildonSound");
+
+  /* Create test cases and add them to the suite */
+  TCase *tc1 = tcase_create("hildon_sound_cache_sample");
+
+  tcase_add_checked_fixture(tc1, fx_setup_samples, fx_teardown_samples);
+  tcase_add_test(tc1, test_sound_cache_sample_regular);
+  tcase_add_test(tc1, test_sound_cache_sample_invalid);
+  suite_add_tcase (s, tc1);
+
+  /* Return created suite */
+  return s;
+}
@@ -0,0 +1,226 @@
+/*
+ * This file is a part of hildon tests
+ *
+ * Copyright (C) 2009 Nokia Corporation, all rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA
+ *
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include <gtk/gtkmain.h>
+#include "test_suites.h"
+#include "check_utils.h"
+#include <hildon/hildon.h>
+
+/* A stackable window type of our own, so that pools of different
+   types can be registered on the same stack */
+typedef HildonStackableWindow TestPooledWindow;
+typedef HildonStackableWindowClass TestPooledWindowClass;
+
+G_DEFINE_TYPE (TestPooledWindow, test_pooled_window, HILDON_TYPE_STACKABLE_WINDOW);
+
+#define TEST_TYPE_POOLED_WINDOW (test_pooled_window_get_type ())
+
+static void
+test_pooled_window_class_init (TestPooledWindowClass *klass)
+{
+}
+
+static void
+test_pooled_window_init (TestPooledWindow *self)
+{
+}
+
+static HildonWindowStack *stack = NULL;
+static gint factory_calls;
+static gint destroy_calls;
+static GtkWidget *invalid_window;
+
+static HildonStackableWindow *
+pooled_window_factory (HildonWindowStack *stack,
+                       gpointer user_data)
+{
+  factory_calls++;
+
+  return g_object_new (TEST_TYPE_POOLED_WINDOW, NULL);
+}
+
+/* Returns a window of the wrong type */
+static HildonStackableWindow *
+invalid_window_factory (HildonWindowStack *stack,
+                        gpointer user_data)
+{
+  factory_calls++;
+
+  invalid_window = hildon_stackable_window_new ();
+  g_object_add_weak_pointer (G_OBJECT (invalid_window), (gpointer *) &invalid_window);
+
+  return HILDON_STACKABLE_WINDOW (invalid_window);
+}
+
+static void
+count_destroy (gpointer data)
+{
+  destroy_calls++;
+}
+
+static void
+process_events (void)
+{
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+}
+
+static void
+fx_setup_window_stack ()
+{
+  int argc = 0;
+
+  gtk_init (&argc, NULL);
+
+  stack = hildon_window_stack_new ();
+  fail_if (!HILDON_IS_WINDOW_STACK (stack),
+           "hildon-window-stack: Creation failed.");
+
+  factory_calls = 0;
+  destroy_calls = 0;
+  invalid_window = NULL;
+}
+
+static void
+fx_teardown_window_stack ()
+{
+  g_object_unref (stack);
+}
+
+/**
+ * Purpose: Check that a pool keeps windows built and reuses recycled ones
+ * Cases considered:
+ *    - Register a factory and let the application go idle.
+ *    - Take the pooled windows.
+ *    - Recycle a window and take it again.
+ *    - Unregister the factory.
+ */
+START_TEST (test_window_stack_pool_regular)
+{
+  GtkWidget *first, *second, *win;
+
+  hildon_window_stack_register_factory (stack, TEST_TYPE_POOLED_WINDOW,
+                                        pooled_window_factory, NULL,
+                                        count_destroy, 2);
+  process_events ();
+
+  fail_if (factory_calls != 2,
+           "hildon-window-stack: %d windows built for a pool of 2", factory_calls);
+
+  /* Test 1: pooled windows are ready */
+  first = hildon_window_stack_get_pooled_window (stack, TEST_TYPE_POOLED_WINDOW);
+  second = hildon_window_stack_get_pooled_window (stack, TEST_TYPE_POOLED_WINDOW);
+
+  fail_if (factory_calls != 2,
+           "hildon-window-stack: Window built while the pool was not empty");
+  fail_if (!G_TYPE_CHECK_INSTANCE_TYPE (first, TEST_TYPE_POOLED_WINDOW) ||
+           !G_TYPE_CHECK_INSTANCE_TYPE (second, TEST_TYPE_POOLED_WINDOW),
+           "hildon-window-stack: Pooled window of the wrong type");
+  fail_if (!GTK_WIDGET_REALIZED (first) || !GTK_WIDGET_REALIZED (second),
+           "hildon-window-stack: Pooled windows are not realized");
+
+  /* Test 2: recycled windows are reused */
+  hildon_window_stack_recycle_window (stack, HILDON_STACKABLE_WINDOW (first));
+  win = hildon_window_stack_get_pooled_window (stack, TEST_TYPE_POOLED_WINDOW);
+
+  fail_if (win != first,
+           "hildon-window-stack: Recycled window was not reused");
+
+  hildon_window_stack_recycle_window (stack, HILDON_STACKABLE_WINDOW (first));
+  hildon_window_stack_recycle_window (stack, HILDON_STACKABLE_WINDOW (second));
+  process_events ();
+
+  fail_if (factory_calls != 2,
+           "hildon-window-stack: Window built for a pool filled with recycled windows");
+
+  /* Test 3: unregistering frees the user data */
+  hildon_window_stack_unregister_factory (stack, TEST_TYPE_POOLED_WINDOW);
+
+  fail_if (destroy_calls != 1,
+           "hildon-window-stack: User data not freed when unregistering");
+  fail_if (hildon_window_stack_get_pooled_window (stack, TEST_TYPE_POOLED_WINDOW) != NULL,
+           "hildon-window-stack: Window returned for an unregistered type");
+}
+END_TEST
+
+/**
+ * Purpose: Check that a factory returning windows of the wrong type
+ *          does not break the other pools
+ * Cases considered:
+ *    - Register a factory returning plain stackable windows for our
+ *      type, and the default factory for stackable windows.
+ *    - Let the application go idle.
+ *    - Take a window from both pools.
+ */
+START_TEST (test_window_stack_pool_invalid)
+{
+  GtkWidget *win;
+
+  hildon_window_stack_register_factory (stack, TEST_TYPE_POOLED_WINDOW,
+                                        invalid_window_factory, NULL, NULL, 2);
+  hildon_window_stack_register_factory (stack, HILDON_TYPE_STACKABLE_WINDOW,
+                                        NULL, NULL, NULL, 1);
+  process_events ();
+
+  fail_if (factory_calls != 1,
+           "hildon-window-stack: Invalid factory called %d times while idle", factory_calls);
+  fail_if (invalid_window != NULL,
+           "hildon-window-stack: Window of the wrong type was not destroyed");
+
+  /* Test 1: no window from the invalid factory */
+  win = hildon_window_stack_get_pooled_window (stack, TEST_TYPE_POOLED_WINDOW);
+
+  fail_if (win != NULL,
+           "hildon-window-stack: Window of the wrong type returned");
+  fail_if (invalid_window != NULL,
+           "hildon-window-stack: Window of the wrong type was not destroyed");
+
+  /* Test 2: the other pool was filled */
+  win = hildon_window_stack_get_pooled_window (stack, HILDON_TYPE_STACKABLE_WINDOW);
+
+  fail_if (!HILDON_IS_STACKABLE_WINDOW (win) || !GTK_WIDGET_REALIZED (win),
+           "hildon-window-stack: Pool of another type was not filled");
+  gtk_widget_destroy (win);
+
+  process_events ();
+
+  fail_if (factory_calls != 2,
+           "hildon-window-stack: Invalid factory retried while idle");
+}
+END_TEST
+
+/* ---------- Suite creation ---------- */
+
+Suite *create_hildon_window_stack_suite (void)
+{
+  Suite *s = suite_create ("HildonWindowStack");
+
+  TCase *tc1 = tcase_create ("hildon_window_stack_pool");
+  tcase_add_checked_fixture (tc1, fx_setup_window_stack, fx_teardown_window_stack);
+  tcase_add_test (tc1, test_window_stack_pool_regular);
+  tcase_add_test (tc1, test_window_stack_pool_invalid);
+  suite_add_tcase (s, tc1);
+
+  return s;
+}
@@ -87,11 +87,17 @@ configure_tests(gint environment)
   srunner_add_suite(sr, create_hildon_window_suite());
   srunner_add_suite(sr, create_hildon_helper_suite());
   srunner_add_suite(sr, create_hildon_picker_button_suite());
+  srunner_add_suite(sr, create_hildon_picker_dialog_suite());
+  srunner_add_suite(sr, create_hildon_button_suite());
+  srunner_add_suite(sr, create_hildon_remote_texture_suite());
+  srunner_add_suite(sr, create_hildon_animation_actor_suite());
+  srunner_add_suite(sr, create_hildon_window_stack_suite());
 
   /* Disable tests that need maemo environment to be up if it is not running */
   if (environment != ENVIRONMENT_MAEMO_ERROR)
     {
       /* srunner_add_suite(sr, create_hildon_system_sound_suite()); */
+      srunner_add_suite(sr, create_hildon_sound_suite());
       /* srunner_add_suite(sr, create_hildon_color_selector_suite()); */
       srunner_add_suite(sr, create_hildon_program_suite());
     }
@@ -63,5 +63,11 @@ Suite *create_hildon_window_suite(void);
 Suite *create_hildon_program_suite(void);
 Suite *create_hildon_composite_widget_suite(void);
 Suite *create_hildon_picker_button_suite (void);
+Suite *create_hildon_picker_dialog_suite (void);
+Suite *create_hildon_button_suite (void);
+Suite *create_hildon_sound_suite(void);
+Suite *create_hildon_remote_texture_suite(void);
+Suite *create_hildon_animation_actor_suite(void);
+Suite *create_hildon_window_stack_suite(void);
 
 #endif